@@ -0,0 +1,63 @@
+// Compare throughput of nonstd::string_view::find() for a substring,
+// with std::search() and, if available, std::string_view::find().
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#if nssv_CPP17_OR_GREATER
+# include <string_view>
+#endif
+
+template< typename F >
+void measure( char const * title, std::size_t bytes, F f )
+{
+    const std::size_t repeat = 20;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result = f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": " << ( static_cast<double>( repeat * bytes ) / seconds / 1e9 ) << " GB/s (" << result << ")\n";
+}
+
+void bench( char const * title, std::string const & hay, std::string const & needle )
+{
+    std::cout << title << " (haystack " << hay.size() << ", needle " << needle.size() << "):\n";
+
+    measure( "nonstd::string_view::find()", hay.size(), [&]{
+        return nonstd::string_view( hay ).find( nonstd::string_view( needle ) ); } );
+
+    measure( "std::search()              ", hay.size(), [&]{
+        return std::size_t( std::search( hay.begin(), hay.end(), needle.begin(), needle.end() ) - hay.begin() ); } );
+
+#if nssv_CPP17_OR_GREATER
+    measure( "std::string_view::find()   ", hay.size(), [&]{
+        return std::string_view( hay ).find( std::string_view( needle ) ); } );
+#endif
+}
+
+int main()
+{
+    std::string text;
+    for ( std::size_t i = 0; text.size() < 16 * 1024 * 1024; ++i )
+        text += "GET /index.html HTTP/1.1\r\nHost: example.org\r\nAccept: */*\r\n\r\n";
+
+    bench( "text, short needle", text, "Content-Length:" );
+    bench( "text, long needle ", text, "multipart/form-data; boundary=----WebKitFormBoundary7MA4YWxkTrZu0gW" );
+
+    const std::string uniform( 4 * 1024 * 1024, 'a' );
+
+    bench( "adversarial, periodic needle", uniform, std::string( 1000, 'a' ) + 'b' );
+}
+
+// g++ -O2 -std=c++17 -I../include -o 03-bench-find.exe 03-bench-find.cpp && 03-bench-find.exe
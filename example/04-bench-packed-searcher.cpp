@@ -0,0 +1,60 @@
+// Compare throughput of nonstd::packed_searcher::find() for a few short
+// needles, with the least of repeated nonstd::string_view::find() and with
+// nonstd::multi_searcher::find().
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template< typename F >
+void measure( char const * title, std::size_t bytes, F f )
+{
+    const std::size_t repeat = 20;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result = f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": " << ( static_cast<double>( repeat * bytes ) / seconds / 1e9 ) << " GB/s (" << result << ")\n";
+}
+
+void bench( char const * title, std::string const & hay, std::vector<nonstd::string_view> const & needles )
+{
+    std::cout << title << " (haystack " << hay.size() << ", needles " << needles.size() << "):\n";
+
+    const nonstd::packed_searcher ps( needles.begin(), needles.end() );
+    const nonstd::multi_searcher  ms( needles.begin(), needles.end() );
+
+    measure( "nonstd::packed_searcher::find()  ", hay.size(), [&]{
+        return ps.find( hay ); } );
+
+    measure( "nonstd::string_view::find(), min ", hay.size(), [&]{
+        std::size_t least = nonstd::string_view::npos;
+        for ( auto needle : needles )
+            least = (std::min)( least, nonstd::string_view( hay ).find( needle ) );
+        return least; } );
+
+    measure( "nonstd::multi_searcher::find()   ", hay.size(), [&]{
+        return ms.find( hay ).pos; } );
+}
+
+int main()
+{
+    std::string text;
+    for ( std::size_t i = 0; text.size() < 16 * 1024 * 1024; ++i )
+        text += "Host: example.org\r\nAccept: */*\r\nUser-Agent: bench/1.0\r\nContent-Type: text/plain\r\n";
+
+    bench( "text, 3 methods ", text, { "GET ", "POST ", "HTTP/" } );
+    bench( "text, 8 needles ", text, { "GET ", "POST ", "PUT ", "DELETE ", "HEAD ", "PATCH ", "HTTP/", "OPTIONS " } );
+}
+
+// g++ -O2 -std=c++17 -mavx2 -I../include -o 04-bench-packed-searcher.exe 04-bench-packed-searcher.cpp && 04-bench-packed-searcher.exe
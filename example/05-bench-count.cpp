@@ -0,0 +1,67 @@
+// Compare throughput of nonstd::string_view::count() for lines and for a
+// substring, with std::count() and with repeated nonstd::string_view::find().
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// keep the compiler from hoisting the counts out of the repeat loop:
+
+volatile std::size_t origin = 0;
+
+template< typename F >
+void measure( char const * title, std::size_t bytes, F f )
+{
+    const std::size_t repeat = 20;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result += f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": " << ( static_cast<double>( repeat * bytes ) / seconds / 1e9 ) << " GB/s (" << result / repeat << ")\n";
+}
+
+void bench( char const * title, std::string const & hay, nonstd::string_view needle )
+{
+    std::cout << title << " (haystack " << hay.size() << ", needle " << needle.size() << "):\n";
+
+    if ( needle.size() == 1 )
+    {
+        measure( "nonstd::string_view::count(CharT)", hay.size(), [&]{
+            return nonstd::string_view( hay ).substr( origin ).count( needle[0] ); } );
+
+        measure( "std::count()                     ", hay.size(), [&]{
+            return std::size_t( std::count( hay.begin() + std::ptrdiff_t( origin ), hay.end(), needle[0] ) ); } );
+    }
+
+    measure( "nonstd::string_view::count(view) ", hay.size(), [&]{
+        return nonstd::string_view( hay ).substr( origin ).count( needle ); } );
+
+    measure( "nonstd::string_view::find(), loop", hay.size(), [&]{
+        const nonstd::string_view text = nonstd::string_view( hay ).substr( origin );
+        std::size_t n = 0;
+        for ( auto pos = text.find( needle ); pos != text.npos; pos = text.find( needle, pos + needle.size() ) )
+            ++n;
+        return n; } );
+}
+
+int main()
+{
+    std::string text;
+    for ( std::size_t i = 0; text.size() < 64 * 1024 * 1024; ++i )
+        text += "GET /index.html HTTP/1.1\r\nHost: example.org\r\nAccept: */*\r\n\r\n";
+
+    bench( "text, lines    ", text, "\n" );
+    bench( "text, substring", text, "\r\nHost:" );
+}
+
+// g++ -O2 -std=c++17 -mavx2 -I../include -o 05-bench-count.exe 05-bench-count.cpp && 05-bench-count.exe
@@ -0,0 +1,99 @@
+// Compare throughput of nonstd::string_view::operator==() for keys of
+// several size classes, with compare() and, if available, std::string_view.
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if nssv_CPP17_OR_GREATER
+# include <string_view>
+#endif
+
+// keep the compiler from hoisting the comparisons out of the repeat loop:
+
+volatile std::size_t origin = 0;
+
+template< typename F >
+void measure( char const * title, std::size_t count, F f )
+{
+    const std::size_t repeat = 20;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result += f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": " << ( seconds / static_cast<double>( repeat * count ) * 1e9 ) << " ns (" << result / repeat << ")\n";
+}
+
+// pairs of equal keys in separate cache-resident storage, every fourth pair
+// differs in its last character:
+
+void bench( std::size_t size )
+{
+    const std::size_t count = 4096;
+    const std::size_t rounds = 256;
+
+    std::string lhs, rhs;
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        std::string key( size, 'k' );
+        for ( std::size_t k = 0; k < size; ++k )
+            key[k] = char( 'a' + ( i * 7 + k * 3 ) % 26 );
+
+        lhs += key;
+        if ( size > 0 && i % 4 == 0 )
+            key[size - 1] = '#';
+        rhs += key;
+    }
+
+    std::vector<nonstd::string_view> lv, rv;
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        lv.push_back( nonstd::string_view( lhs.data() + i * size, size ) );
+        rv.push_back( nonstd::string_view( rhs.data() + i * size, size ) );
+    }
+
+    std::cout << "keys of " << size << " characters:\n";
+
+    measure( "nonstd::string_view operator==()", rounds * count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t r = 0; r < rounds; ++r )
+            for ( std::size_t i = origin; i < count; ++i )
+                n += lv[i] == rv[i];
+        return n; } );
+
+    measure( "nonstd::string_view compare()   ", rounds * count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t r = 0; r < rounds; ++r )
+            for ( std::size_t i = origin; i < count; ++i )
+                n += lv[i].compare( rv[i] ) == 0;
+        return n; } );
+
+#if nssv_CPP17_OR_GREATER
+    measure( "std::string_view operator==()   ", rounds * count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t r = 0; r < rounds; ++r )
+            for ( std::size_t i = origin; i < count; ++i )
+                n += std::string_view( lv[i].data(), lv[i].size() ) == std::string_view( rv[i].data(), rv[i].size() );
+        return n; } );
+#endif
+}
+
+int main()
+{
+    const std::size_t sizes[] = { 3, 4, 7, 8, 12, 16, 24, 32, 64 };
+
+    for ( std::size_t size : sizes )
+        bench( size );
+}
+
+// g++ -O2 -std=c++17 -I../include -o 06-bench-equal.exe 06-bench-equal.cpp && 06-bench-equal.exe
@@ -0,0 +1,86 @@
+// Compare throughput of nonstd::sv_hash() for keys of several size classes,
+// with std::hash of nonstd::string_view and, if available, of std::string_view.
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if nssv_CPP17_OR_GREATER
+# include <string_view>
+#endif
+
+// keep the compiler from hoisting the hashes out of the repeat loop:
+
+volatile std::size_t origin = 0;
+
+template< typename F >
+void measure( char const * title, std::size_t count, std::size_t bytes, F f )
+{
+    const std::size_t repeat = 20;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result += f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": "
+        << ( seconds / static_cast<double>( repeat * count ) * 1e9 ) << " ns, "
+        << ( static_cast<double>( repeat * count * bytes ) / seconds / 1e9 ) << " GB/s (" << ( result & 0xff ) << ")\n";
+}
+
+// cache-resident keys of the given size, a power of two of them, hashed round-robin:
+
+void bench( std::size_t size )
+{
+    const std::size_t keys  = size < 4096 ? 4096 : 16;
+    const std::size_t count = ( 64 * 1024 * 1024 ) / ( size + 16 );
+
+    std::string text;
+    for ( std::size_t i = 0; i < keys * size; ++i )
+        text += char( 'a' + ( i * 7 + i / 13 ) % 26 );
+
+    std::vector<nonstd::string_view> views;
+    for ( std::size_t i = 0; i < keys; ++i )
+        views.push_back( nonstd::string_view( text.data() + i * size, size ) );
+
+    std::cout << "keys of " << size << " characters:\n";
+
+    measure( "nonstd::sv_hash()                   ", count, size, [&]{
+        std::size_t h = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            h += std::size_t( nonstd::sv_hash( views[ i & ( keys - 1 ) ] ) );
+        return h; } );
+
+    measure( "std::hash<nonstd::string_view>()    ", count, size, [&]{
+        std::size_t h = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            h += std::hash<nonstd::string_view>()( views[ i & ( keys - 1 ) ] );
+        return h; } );
+
+#if nssv_CPP17_OR_GREATER
+    measure( "std::hash<std::string_view>()       ", count, size, [&]{
+        std::size_t h = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            h += std::hash<std::string_view>()( std::string_view( views[ i & ( keys - 1 ) ].data(), size ) );
+        return h; } );
+#endif
+}
+
+int main()
+{
+    const std::size_t sizes[] = { 4, 8, 16, 32, 64, 256, 1024, 64 * 1024 };
+
+    for ( std::size_t size : sizes )
+        bench( size );
+}
+
+// g++ -O2 -std=c++17 -mavx2 -I../include -o 07-bench-hash.exe 07-bench-hash.cpp && 07-bench-hash.exe
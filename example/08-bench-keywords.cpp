@@ -0,0 +1,105 @@
+// Compare lookup time of nonstd::keyword_set and nonstd::basic_fixed_keyword_set
+// for SQL keywords and identifiers, with std::unordered_set and a linear search.
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// keep the compiler from hoisting the lookups out of the repeat loop:
+
+volatile std::size_t origin = 0;
+
+template< typename F >
+void measure( char const * title, std::size_t count, F f )
+{
+    const std::size_t repeat = 20;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result += f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": "
+        << ( seconds / static_cast<double>( repeat * count ) * 1e9 ) << " ns (" << result << ")\n";
+}
+
+nssv_constexpr nonstd::string_view sql[] =
+{
+    "ADD", "ALL", "ALTER", "AND", "ANY", "AS", "ASC", "BACKUP", "BETWEEN", "BY",
+    "CASE", "CHECK", "COLUMN", "CONSTRAINT", "CREATE", "DATABASE", "DEFAULT", "DELETE", "DESC", "DISTINCT",
+    "DROP", "EXEC", "EXISTS", "FOREIGN", "FROM", "FULL", "GROUP", "HAVING", "IN", "INDEX",
+    "INNER", "INSERT", "INTO", "IS", "JOIN", "KEY", "LEFT", "LIKE", "LIMIT", "NOT",
+    "NULL", "OR", "ORDER", "OUTER", "PRIMARY", "PROCEDURE", "RIGHT", "ROWNUM", "SELECT", "SET",
+    "TABLE", "TOP", "TRUNCATE", "UNION", "UNIQUE", "UPDATE", "VALUES", "VIEW", "WHERE", "WITH",
+};
+
+#if nssv_HAVE_CONSTEXPR_14
+constexpr auto fixed = nonstd::make_keyword_set( sql );
+#else
+const auto fixed = nonstd::make_keyword_set( sql );
+#endif
+
+void bench( char const * title, std::vector<nonstd::string_view> const & tokens )
+{
+    const std::size_t count = 16 * 1024 * 1024;
+    const std::size_t mask  = tokens.size() - 1;
+
+    const nonstd::keyword_set runtime( std::begin( sql ), std::end( sql ) );
+    const std::unordered_set<nonstd::string_view> hashed( std::begin( sql ), std::end( sql ) );
+
+    std::cout << title << ":\n";
+
+    measure( "nonstd::basic_fixed_keyword_set::find()", count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            n += fixed.find( tokens[ i & mask ] ) != nonstd::string_view::npos;
+        return n; } );
+
+    measure( "nonstd::keyword_set::find()            ", count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            n += runtime.find( tokens[ i & mask ] ) != nonstd::string_view::npos;
+        return n; } );
+
+    measure( "std::unordered_set::count()            ", count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            n += hashed.count( tokens[ i & mask ] );
+        return n; } );
+
+    measure( "std::find()                            ", count, [&]{
+        std::size_t n = 0;
+        for ( std::size_t i = origin; i < count; ++i )
+            n += std::find( std::begin( sql ), std::end( sql ), tokens[ i & mask ] ) != std::end( sql );
+        return n; } );
+}
+
+int main()
+{
+    // a power of two of tokens, looked up round-robin:
+
+    std::vector<nonstd::string_view> keywords;
+    for ( std::size_t i = 0; i < 1024; ++i )
+        keywords.push_back( sql[ ( i * 7 ) % fixed.size() ] );
+
+    std::vector<std::string> names;
+    for ( std::size_t i = 0; i < 1024; ++i )
+        names.push_back( "column_" + std::to_string( i ) );
+
+    std::vector<nonstd::string_view> identifiers( names.begin(), names.end() );
+
+    bench( "keywords   ", keywords );
+    bench( "identifiers", identifiers );
+}
+
+// g++ -O2 -std=c++17 -I../include -o 08-bench-keywords.exe 08-bench-keywords.cpp && 08-bench-keywords.exe
@@ -0,0 +1,94 @@
+// Compare insertion and lookup time of nonstd::basic_string_map with
+// std::unordered_map of std::string keys, for keys of several sizes.
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+
+#include "nonstd/string_view.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// keep the compiler from hoisting the lookups out of the repeat loop:
+
+volatile std::size_t origin = 0;
+
+template< typename F >
+void measure( char const * title, std::size_t count, F f )
+{
+    const std::size_t repeat = 5;
+    std::size_t result = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( std::size_t i = 0; i < repeat; ++i )
+        result += f();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::cout << "  " << title << ": "
+        << ( seconds / static_cast<double>( repeat * count ) * 1e9 ) << " ns (" << result << ")\n";
+}
+
+// keys of size characters, a power of two of them, looked up in a shuffled order:
+
+void bench( std::size_t size, std::size_t keys )
+{
+    std::vector<std::string> names;
+    for ( std::size_t i = 0; i < keys; ++i )
+    {
+        std::string name = std::to_string( ( i * 2654435761u ) & 0xffffffffu ) + ".metric";
+        name.resize( size, '_' );
+        names.push_back( name );
+    }
+
+    std::vector<nonstd::string_view> probes;
+    for ( std::size_t i = 0; i < keys; ++i )
+        probes.push_back( names[ ( i * 40503u ) & ( keys - 1 ) ] );
+
+    std::cout << keys << " keys of " << size << " characters:\n";
+
+    measure( "nonstd::basic_string_map::emplace()", keys, [&]{
+        nonstd::basic_string_map<char, std::size_t> map;
+        for ( std::size_t i = origin; i < keys; ++i )
+            map.emplace( names[i], i );
+        return map.size(); } );
+
+    measure( "std::unordered_map::emplace()      ", keys, [&]{
+        std::unordered_map<std::string, std::size_t> map;
+        for ( std::size_t i = origin; i < keys; ++i )
+            map.emplace( names[i], i );
+        return map.size(); } );
+
+    nonstd::basic_string_map<char, std::size_t> flat;
+    std::unordered_map<std::string, std::size_t> node;
+
+    for ( std::size_t i = 0; i < keys; ++i )
+    {
+        flat.emplace( names[i], i );
+        node.emplace( names[i], i );
+    }
+
+    measure( "nonstd::basic_string_map::find()   ", keys, [&]{
+        std::size_t n = 0;
+        for ( std::size_t i = origin; i < keys; ++i )
+            n += *flat.find( probes[i] );
+        return n; } );
+
+    measure( "std::unordered_map::find()         ", keys, [&]{
+        std::size_t n = 0;
+        for ( std::size_t i = origin; i < keys; ++i )
+            n += node.find( std::string( probes[i] ) )->second;
+        return n; } );
+}
+
+int main()
+{
+    bench( 12, 1024 );
+    bench( 12, 1024 * 1024 );
+    bench( 40, 1024 * 1024 );
+}
+
+// g++ -O2 -std=c++17 -I../include -o 09-bench-string-map.exe 09-bench-string-map.cpp && 09-bench-string-map.exe
@@ -0,0 +1,86 @@
+// Compare time to intern names of nonstd::string_pool with a mutex-guarded
+// std::unordered_map of std::string keys, on all hardware threads.
+
+#define nssv_CONFIG_SELECT_STRING_VIEW  nssv_STRING_VIEW_NONSTD
+#define nssv_CONFIG_STRING_POOL         1
+
+#include "nonstd/string_view.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// run f( thread ) on each of threads threads, and report the time per call of count calls per thread:
+
+template< typename F >
+void measure( char const * title, unsigned threads, std::size_t count, F f )
+{
+    std::vector<std::thread> pool;
+    std::vector<std::size_t> result( threads );
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( unsigned t = 0; t < threads; ++t )
+        pool.emplace_back( [&, t]{ result[t] = f( t ); } );
+    for ( auto & thread : pool )
+        thread.join();
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+    std::size_t sum = 0;
+    for ( std::size_t r : result )
+        sum += r;
+
+    std::cout << "  " << title << ": "
+        << ( seconds / static_cast<double>( threads * count ) * 1e9 ) << " ns (" << ( sum & 0xff ) << ")\n";
+}
+
+// names, a power of two of them, interned in a different order on each thread:
+
+void bench( std::size_t names_count, unsigned threads )
+{
+    const std::size_t count = 4 * 1024 * 1024;
+    const std::size_t mask  = names_count - 1;
+
+    std::vector<std::string> names;
+    for ( std::size_t i = 0; i < names_count; ++i )
+        names.push_back( "service.requests." + std::to_string( i * 2654435761u & 0xffffffffu ) + ".count" );
+
+    std::cout << names_count << " names, " << threads << " threads:\n";
+
+    nonstd::string_pool pool;
+
+    measure( "nonstd::string_pool::intern()        ", threads, count, [&]( unsigned t ){
+        std::size_t n = 0;
+        for ( std::size_t i = 0; i < count; ++i )
+            n += pool.intern( names[ ( i * 40503u + t * 977u ) & mask ] ).id;
+        return n; } );
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::uint32_t> map;
+
+    measure( "std::mutex and std::unordered_map    ", threads, count, [&]( unsigned t ){
+        std::size_t n = 0;
+        for ( std::size_t i = 0; i < count; ++i )
+        {
+            std::string const & name = names[ ( i * 40503u + t * 977u ) & mask ];
+            std::lock_guard<std::mutex> lock( mutex );
+            n += map.emplace( name, static_cast<std::uint32_t>( map.size() ) ).first->second;
+        }
+        return n; } );
+}
+
+int main()
+{
+    const unsigned threads = std::thread::hardware_concurrency() != 0 ? std::thread::hardware_concurrency() : 1;
+
+    bench( 1024, threads );
+    bench( 1024 * 1024, threads );
+}
+
+// g++ -O2 -std=c++17 -pthread -I../include -o 10-bench-string-pool.exe 10-bench-string-pool.cpp && 10-bench-string-pool.exe
@@ -73,6 +73,14 @@
 # define nssv_CONFIG_CONSTEXPR11_STD_SEARCH  1
 #endif
 
+#ifndef  nssv_CONFIG_NO_SIMD
+# define nssv_CONFIG_NO_SIMD  0
+#endif
+
+#ifndef  nssv_CONFIG_STRING_POOL
+# define nssv_CONFIG_STRING_POOL  0
+#endif
+
 // Control presence of exception handling (try and auto discover):
 
 #ifndef nssv_CONFIG_NO_EXCEPTIONS
@@ -319,8 +327,17 @@ using std::operator<<;
 
 #define nssv_HAVE_NODISCARD             nssv_CPP17_000
 
+// Presence of C++20 language features:
+
+#if nssv_CPP20_OR_GREATER && defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+# define nssv_HAVE_THREE_WAY_COMPARISON  1
+#else
+# define nssv_HAVE_THREE_WAY_COMPARISON  0
+#endif
+
 // Presence of C++ library features:
 
+#define nssv_HAVE_INITIALIZER_LIST      nssv_CPP11_120
 #define nssv_HAVE_STD_HASH              nssv_CPP11_120
 
 // Presence of compiler intrinsics:
@@ -362,6 +379,78 @@ using std::operator<<;
 # define nssv_BUILTIN_STRLEN  strlen
 #endif
 
+// Distinguish constant evaluation from run-time evaluation, so that the
+// (vectorized) run-time search engines are only used outside the former.
+// Without a means to tell, constexpr functions use their constexpr path:
+
+#if ! nssv_HAVE_CONSTEXPR_11
+# define nssv_HAVE_IS_CONSTANT_EVALUATED  1
+# define nssv_is_constant_evaluated()     false
+#elif nssv_HAVE_BUILTIN(__builtin_is_constant_evaluated) || nssv_COMPILER_GNUC_VERSION >= 900 || nssv_COMPILER_MSVC_VER >= 1925
+# define nssv_HAVE_IS_CONSTANT_EVALUATED  1
+# define nssv_is_constant_evaluated()     __builtin_is_constant_evaluated()
+#else
+# define nssv_HAVE_IS_CONSTANT_EVALUATED  0
+# define nssv_is_constant_evaluated()     true
+#endif
+
+// for use in nssv_constexpr14 functions:
+
+#if nssv_HAVE_CONSTEXPR_14
+# define nssv_is_constant_evaluated14()  nssv_is_constant_evaluated()
+#else
+# define nssv_is_constant_evaluated14()  false
+#endif
+
+// Presence of SIMD instruction sets, see also nssv_CONFIG_NO_SIMD:
+
+#if ! nssv_CONFIG_NO_SIMD && ( defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) )
+# define nssv_HAVE_SSE2  1
+#else
+# define nssv_HAVE_SSE2  0
+#endif
+
+#if ! nssv_CONFIG_NO_SIMD && ( defined(__SSSE3__) || defined(__AVX__) || defined(__AVX2__) )
+# define nssv_HAVE_SSSE3  1
+#else
+# define nssv_HAVE_SSSE3  0
+#endif
+
+#if ! nssv_CONFIG_NO_SIMD && defined(__AVX2__)
+# define nssv_HAVE_AVX2  1
+#else
+# define nssv_HAVE_AVX2  0
+#endif
+
+// Byte order, to read little-endian words from memory:
+
+#if ( defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ) \
+    || defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64)
+# define nssv_HAVE_LITTLE_ENDIAN  1
+#else
+# define nssv_HAVE_LITTLE_ENDIAN  0
+#endif
+
+// Aligned vector loads do not cross a page boundary, but may read beyond the
+// end of an object; exempt such functions from address sanitizing:
+
+#if defined(__clang__) || nssv_COMPILER_GNUC_VERSION >= 480
+# define nssv_NO_SANITIZE_ADDRESS  __attribute__((no_sanitize_address))
+#else
+# define nssv_NO_SANITIZE_ADDRESS
+#endif
+
+// Keep the paths for longer input out of the callers, such that the compiler
+// does not analyze them for the bounds of a short argument:
+
+#if defined(__GNUC__) || defined(__clang__)
+# define nssv_NOINLINE  __attribute__((noinline))
+#elif nssv_COMPILER_MSVC_VER
+# define nssv_NOINLINE  __declspec(noinline)
+#else
+# define nssv_NOINLINE
+#endif
+
 // C++ feature usage:
 
 #if nssv_HAVE_CONSTEXPR_11
@@ -418,9 +507,13 @@ using std::operator<<;
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>  // std::strlen()
+#include <cwchar>   // std::wcslen()
 #include <iterator>
 #include <limits>
 #include <string>   // std::char_traits<>
+#include <utility>  // std::pair<>
+#include <vector>
 
 #if ! nssv_CONFIG_NO_STREAM_INSERTION
 # include <ostream>
@@ -431,9 +524,35 @@ using std::operator<<;
 #endif
 
 #if nssv_CPP11_OR_GREATER
+# include <cstdint>
 # include <type_traits>
 #endif
 
+#if nssv_CPP11_OR_GREATER && nssv_CONFIG_STRING_POOL
+# include <atomic>
+# include <mutex>
+#endif
+
+#if nssv_HAVE_INITIALIZER_LIST
+# include <initializer_list>
+#endif
+
+#if nssv_HAVE_THREE_WAY_COMPARISON
+# include <compare>
+#endif
+
+#if nssv_HAVE_AVX2
+# include <immintrin.h>
+#elif nssv_HAVE_SSSE3
+# include <tmmintrin.h>
+#elif nssv_HAVE_SSE2
+# include <emmintrin.h>
+#endif
+
+#if nssv_COMPILER_MSVC_VER
+# include <intrin.h>
+#endif
+
 // Clang, GNUC, MSVC warning suppression macros:
 
 #if defined(__clang__)
@@ -476,6 +595,25 @@ nssv_DISABLE_MSVC_WARNINGS( 4455 26481 26472 )
 //nssv_DISABLE_CLANG_WARNINGS( "-Wuser-defined-literals" )
 //nssv_DISABLE_GNUC_WARNINGS( -Wliteral-suffix )
 
+#if nssv_CPP11_OR_GREATER
+
+namespace nonstd {
+
+// Traits whose eq() compares character values, like std::char_traits, such
+// that a view may be hashed via its characters; specialize as true_type to
+// enable std::hash, sv_hasher and sv_equal for views with other traits
+// (extension, C++11):
+
+template< class Traits >
+struct hashes_by_value : std::false_type {};
+
+template< class CharT >
+struct hashes_by_value< std::char_traits<CharT> > : std::true_type {};
+
+} // namespace nonstd
+
+#endif // nssv_CPP11_OR_GREATER
+
 namespace nonstd { namespace sv_lite {
 
 //
@@ -489,8 +627,19 @@ template
 >
 class basic_string_view;
 
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_char_set;
+
 namespace detail {
 
+// position value for 'not found', equal to basic_string_view::npos:
+
+const std::size_t npos = std::size_t(-1);
+
 // support constexpr comparison in C++14;
 // for C++17 and later, use provided traits:
 
@@ -528,23 +677,49 @@ inline nssv_constexpr std::size_t length( char const * s )
 
 #endif
 
-#if defined(__OPTIMIZE__)
+// constant evaluation of length() and search() in C++11, where a constexpr
+// function is a single return statement: divide and conquer keeps the
+// recursion depth logarithmic in the length, where a recursion per
+// character hits the compiler's constexpr depth limit (512 for GCC).
+
+// index of the first '\0' in [s, s + n), or n, n > 0; reads no character beyond it:
+
+template< typename CharT >
+inline nssv_constexpr std::size_t nul_index( CharT * s, std::size_t n );
+
+template< typename CharT >
+inline nssv_constexpr std::size_t nul_index_right( std::size_t left, CharT * s, std::size_t n )
+{
+    return left < n / 2 ? left : n / 2 + nul_index( s + n / 2, n - n / 2 );
+}
+
+template< typename CharT >
+inline nssv_constexpr std::size_t nul_index( CharT * s, std::size_t n )
+{
+    return n == 1 ? ( *s == CharT() ? 0 : 1 ) : nul_index_right( nul_index( s, n / 2 ), s, n );
+}
+
+// length of s, probing blocks of doubling size n:
 
-// gcc, clang provide __OPTIMIZE__
-// Expect tail call optimization to make length() non-recursive:
+template< typename CharT >
+inline nssv_constexpr std::size_t length_from( CharT * s, std::size_t n );
 
 template< typename CharT >
-inline nssv_constexpr std::size_t length( CharT * s, std::size_t result = 0 )
+inline nssv_constexpr std::size_t length_next( std::size_t idx, CharT * s, std::size_t n )
 {
-    return *s == '\0' ? result : length( s + 1, result + 1 );
+    return idx < n ? idx : n + length_from( s + n, 2 * n );
 }
 
-#else // OPTIMIZE
+template< typename CharT >
+inline nssv_constexpr std::size_t length_from( CharT * s, std::size_t n )
+{
+    return length_next( nul_index( s, n ), s, n );
+}
 
-// non-recursive:
+// non-recursive, constexpr since C++14:
 
 template< typename CharT >
-inline nssv_constexpr14 std::size_t length( CharT * s )
+inline nssv_constexpr14 std::size_t length_loop( CharT * s )
 {
     std::size_t result = 0;
     while ( *s++ != '\0' )
@@ -554,950 +729,5934 @@ inline nssv_constexpr14 std::size_t length( CharT * s )
     return result;
 }
 
-#endif // OPTIMIZE
+// run-time length of s, see length_runtime() further below:
 
-#if nssv_CPP11_OR_GREATER && ! nssv_CPP17_OR_GREATER
-#if defined(__OPTIMIZE__)
+template< typename CharT >
+std::size_t length_runtime( CharT const * s );
 
-// gcc, clang provide __OPTIMIZE__
-// Expect tail call optimization to make search() non-recursive:
+inline std::size_t length_runtime( char const * s )
+{
+    return std::strlen( s );
+}
 
-template< class CharT, class Traits = std::char_traits<CharT> >
-constexpr const CharT* search( basic_string_view<CharT, Traits> haystack, basic_string_view<CharT, Traits> needle )
+inline std::size_t length_runtime( wchar_t const * s )
 {
-    return haystack.starts_with( needle ) ? haystack.begin() :
-        haystack.empty() ? haystack.end() : search( haystack.substr(1), needle );
+    return std::wcslen( s );
 }
 
-#else // OPTIMIZE
+template< typename CharT >
+inline nssv_constexpr std::size_t length( CharT * s )
+{
+#if nssv_HAVE_CONSTEXPR_14
+    return nssv_is_constant_evaluated() ? length_loop( s ) : length_runtime( s );
+#else
+    return nssv_is_constant_evaluated() ? length_from( s, 1 ) : length_runtime( s );
+#endif
+}
 
-// non-recursive:
+#if nssv_CPP11_OR_GREATER && ! nssv_CPP20_OR_GREATER
 
-#if nssv_CONFIG_CONSTEXPR11_STD_SEARCH
+// whether needle [p, p + m) occurs at s:
 
-template< class CharT, class Traits = std::char_traits<CharT> >
-constexpr const CharT* search( basic_string_view<CharT, Traits> haystack, basic_string_view<CharT, Traits> needle )
+template< class Traits, typename CharT >
+constexpr bool matches_at( CharT const * s, CharT const * p, std::size_t m )
 {
-    return std::search( haystack.begin(), haystack.end(), needle.begin(), needle.end() );
+    return m == 0 ? true
+        :  m == 1 ? Traits::eq( *s, *p )
+        :  matches_at<Traits>( s, p, m / 2 ) && matches_at<Traits>( s + m / 2, p + m / 2, m - m / 2 );
 }
 
-#else // nssv_CONFIG_CONSTEXPR11_STD_SEARCH
+// first index i in [first, first + count) where needle [p, p + m) occurs at s + i, or npos, count > 0:
 
-template< class CharT, class Traits = std::char_traits<CharT> >
-nssv_constexpr14 const CharT* search( basic_string_view<CharT, Traits> haystack, basic_string_view<CharT, Traits> needle )
+template< class Traits, typename CharT >
+constexpr std::size_t search_index( CharT const * s, CharT const * p, std::size_t m, std::size_t first, std::size_t count );
+
+template< class Traits, typename CharT >
+constexpr std::size_t search_index_right( std::size_t left, CharT const * s, CharT const * p, std::size_t m, std::size_t first, std::size_t count )
 {
-    while ( needle.size() <= haystack.size() )
-    {
-        if  ( haystack.starts_with(needle) )
-        {
-            return haystack.cbegin();
-        }
-        haystack = basic_string_view<CharT, Traits>{ haystack.begin() + 1, haystack.size() - 1U };
-    }
-    return haystack.cend();
+    return left != npos ? left : search_index<Traits>( s, p, m, first + count / 2, count - count / 2 );
 }
-#endif // nssv_CONFIG_CONSTEXPR11_STD_SEARCH
 
-#endif // OPTIMIZE
-#endif // nssv_CPP11_OR_GREATER && ! nssv_CPP17_OR_GREATER
+template< class Traits, typename CharT >
+constexpr std::size_t search_index( CharT const * s, CharT const * p, std::size_t m, std::size_t first, std::size_t count )
+{
+    return count == 1
+        ? ( matches_at<Traits>( s + first, p, m ) ? first : npos )
+        : search_index_right<Traits>( search_index<Traits>( s, p, m, first, count / 2 ), s, p, m, first, count );
+}
 
-} // namespace detail
+template< class CharT, class Traits >
+constexpr const CharT* search_result( basic_string_view<CharT, Traits> haystack, std::size_t idx )
+{
+    return idx == npos ? haystack.end() : haystack.begin() + idx;
+}
+
+template< class CharT, class Traits = std::char_traits<CharT> >
+constexpr const CharT* search( basic_string_view<CharT, Traits> haystack, basic_string_view<CharT, Traits> needle )
+{
+    return needle.size() > haystack.size()
+        ? haystack.end()
+        : search_result( haystack, search_index<Traits>( haystack.data(), needle.data(), needle.size(), 0, haystack.size() - needle.size() + 1 ) );
+}
+
+#endif // nssv_CPP11_OR_GREATER && ! nssv_CPP20_OR_GREATER
 
 //
-// basic_string_view:
+// Run-time search engines, used outside constant evaluation:
 //
 
-template
-<
-    class CharT,
-    class Traits /* = std::char_traits<CharT> */
->
-class basic_string_view
+// index idx offset by pos, or npos:
+
+inline std::size_t add_pos( std::size_t pos, std::size_t idx )
 {
-public:
-    // Member types:
+    return idx == npos ? npos : pos + idx;
+}
 
-    typedef Traits traits_type;
-    typedef CharT  value_type;
+template< bool B >
+struct bool_constant { enum { value = B }; };
 
-    typedef CharT       * pointer;
-    typedef CharT const * const_pointer;
-    typedef CharT       & reference;
-    typedef CharT const & const_reference;
+typedef bool_constant<true > true_type;
+typedef bool_constant<false> false_type;
 
-    typedef const_pointer iterator;
-    typedef const_pointer const_iterator;
-    typedef std::reverse_iterator< const_iterator > reverse_iterator;
-    typedef std::reverse_iterator< const_iterator > const_reverse_iterator;
+// T in a non-deduced context:
 
-    typedef std::size_t     size_type;
-    typedef std::ptrdiff_t  difference_type;
+template< typename T >
+struct identity { typedef T type; };
 
-    // 24.4.2.1 Construction and assignment:
+// std::char_traits<CharT> for the standard character types,
+// where eq() and lt() compare the character values:
 
-    nssv_constexpr basic_string_view() nssv_noexcept
-        : data_( nssv_nullptr )
-        , size_( 0 )
-    {}
+template< class CharT, class Traits >
+struct is_std_char_traits : false_type {};
 
-#if nssv_CPP11_OR_GREATER
-    nssv_constexpr basic_string_view( basic_string_view const & other ) nssv_noexcept = default;
+template<> struct is_std_char_traits< char   , std::char_traits<char   > > : true_type {};
+template<> struct is_std_char_traits< wchar_t, std::char_traits<wchar_t> > : true_type {};
+#if nssv_HAVE_WCHAR16_T
+template<> struct is_std_char_traits< char16_t, std::char_traits<char16_t> > : true_type {};
+#endif
+#if nssv_HAVE_WCHAR32_T
+template<> struct is_std_char_traits< char32_t, std::char_traits<char32_t> > : true_type {};
+#endif
+#if defined(__cpp_char8_t)
+template<> struct is_std_char_traits< char8_t, std::char_traits<char8_t> > : true_type {};
+#endif
+
+// characters that can be processed in SIMD lanes of 1, 2 or 4 bytes:
+
+template< class CharT, class Traits >
+struct use_simd : bool_constant<
+    ( nssv_HAVE_SSE2 != 0 )
+    && is_std_char_traits<CharT, Traits>::value
+    && ( sizeof(CharT) == 1 || sizeof(CharT) == 2 || sizeof(CharT) == 4 ) > {};
+
+// index of lowest set bit, x != 0:
+
+inline unsigned ctz( unsigned x )
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned>( __builtin_ctz( x ) );
+#elif nssv_COMPILER_MSVC_VER
+    unsigned long i = 0; _BitScanForward( &i, x ); return static_cast<unsigned>( i );
 #else
-    nssv_constexpr basic_string_view( basic_string_view const & other ) nssv_noexcept
-        : data_( other.data_)
-        , size_( other.size_)
-    {}
+    unsigned n = 0; while ( ( x & 1u ) == 0 ) { x >>= 1; ++n; } return n;
 #endif
+}
 
-    nssv_constexpr basic_string_view( CharT const * s, size_type count ) nssv_noexcept // non-standard noexcept
-        : data_( s )
-        , size_( count )
-    {}
+// index of highest set bit, x != 0:
 
-    nssv_constexpr basic_string_view( CharT const * s) nssv_noexcept // non-standard noexcept
-        : data_( s )
-#if nssv_CPP17_OR_GREATER
-        , size_( Traits::length(s) )
-#elif nssv_CPP11_OR_GREATER
-        , size_( detail::length(s) )
+inline unsigned bsr( unsigned x )
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned>( std::numeric_limits<unsigned>::digits - 1 - __builtin_clz( x ) );
+#elif nssv_COMPILER_MSVC_VER
+    unsigned long i = 0; _BitScanReverse( &i, x ); return static_cast<unsigned>( i );
 #else
-        , size_( Traits::length(s) )
+    unsigned n = 0; while ( x >>= 1 ) { ++n; } return n;
 #endif
-    {}
+}
 
-#if  nssv_HAVE_NULLPTR
-# if nssv_HAVE_IS_DELETE
-    nssv_constexpr basic_string_view( std::nullptr_t ) nssv_noexcept = delete;
-# else
-    private: nssv_constexpr basic_string_view( std::nullptr_t ) nssv_noexcept; public:
-# endif
+#if nssv_HAVE_SSE2
+
+// SSE2 operations on lanes of 1, 2 or 4 bytes; fold() maps ASCII 'A'-'Z'
+// to 'a'-'z' by adding 0x20 to lanes that are below 26 after subtracting 'A':
+
+template< std::size_t N > struct sse2_lanes;
+
+template<> struct sse2_lanes<1>
+{
+    template< typename CharT >
+    static __m128i splat( CharT c ) { return _mm_set1_epi8( static_cast<char>( c ) ); }
+    static __m128i eq( __m128i a, __m128i b ) { return _mm_cmpeq_epi8( a, b ); }
+    static __m128i fold( __m128i x ) { return _mm_or_si128( x, _mm_and_si128( _mm_set1_epi8( 0x20 ),
+        _mm_cmpgt_epi8( _mm_set1_epi8( -0x80 + 26 ), _mm_add_epi8( x, _mm_set1_epi8( 0x80 - 'A' ) ) ) ) ); }
+#if nssv_HAVE_AVX2
+    template< typename CharT >
+    static __m256i splat256( CharT c ) { return _mm256_set1_epi8( static_cast<char>( c ) ); }
+    static __m256i eq( __m256i a, __m256i b ) { return _mm256_cmpeq_epi8( a, b ); }
+    static __m256i fold( __m256i x ) { return _mm256_or_si256( x, _mm256_and_si256( _mm256_set1_epi8( 0x20 ),
+        _mm256_cmpgt_epi8( _mm256_set1_epi8( -0x80 + 26 ), _mm256_add_epi8( x, _mm256_set1_epi8( 0x80 - 'A' ) ) ) ) ); }
 #endif
+};
 
-    // Assignment:
+template<> struct sse2_lanes<2>
+{
+    template< typename CharT >
+    static __m128i splat( CharT c ) { return _mm_set1_epi16( static_cast<short>( c ) ); }
+    static __m128i eq( __m128i a, __m128i b ) { return _mm_cmpeq_epi16( a, b ); }
+    static __m128i fold( __m128i x ) { return _mm_or_si128( x, _mm_and_si128( _mm_set1_epi16( 0x20 ),
+        _mm_cmpgt_epi16( _mm_set1_epi16( -0x8000 + 26 ), _mm_add_epi16( x, _mm_set1_epi16( 0x8000 - 'A' ) ) ) ) ); }
+#if nssv_HAVE_AVX2
+    template< typename CharT >
+    static __m256i splat256( CharT c ) { return _mm256_set1_epi16( static_cast<short>( c ) ); }
+    static __m256i eq( __m256i a, __m256i b ) { return _mm256_cmpeq_epi16( a, b ); }
+    static __m256i fold( __m256i x ) { return _mm256_or_si256( x, _mm256_and_si256( _mm256_set1_epi16( 0x20 ),
+        _mm256_cmpgt_epi16( _mm256_set1_epi16( -0x8000 + 26 ), _mm256_add_epi16( x, _mm256_set1_epi16( 0x8000 - 'A' ) ) ) ) ); }
+#endif
+};
 
-#if nssv_CPP11_OR_GREATER
-    nssv_constexpr14 basic_string_view & operator=( basic_string_view const & other ) nssv_noexcept = default;
-#else
-    nssv_constexpr14 basic_string_view & operator=( basic_string_view const & other ) nssv_noexcept
-    {
-        data_ = other.data_;
-        size_ = other.size_;
-        return *this;
-    }
+template<> struct sse2_lanes<4>
+{
+    template< typename CharT >
+    static __m128i splat( CharT c ) { return _mm_set1_epi32( static_cast<int>( c ) ); }
+    static __m128i eq( __m128i a, __m128i b ) { return _mm_cmpeq_epi32( a, b ); }
+    static __m128i fold( __m128i x ) { return _mm_or_si128( x, _mm_and_si128( _mm_set1_epi32( 0x20 ),
+        _mm_cmpgt_epi32( _mm_set1_epi32( -0x7fffffff - 1 + 26 ), _mm_add_epi32( x, _mm_set1_epi32( 0x7fffffff - 'A' + 1 ) ) ) ) ); }
+#if nssv_HAVE_AVX2
+    template< typename CharT >
+    static __m256i splat256( CharT c ) { return _mm256_set1_epi32( static_cast<int>( c ) ); }
+    static __m256i eq( __m256i a, __m256i b ) { return _mm256_cmpeq_epi32( a, b ); }
+    static __m256i fold( __m256i x ) { return _mm256_or_si256( x, _mm256_and_si256( _mm256_set1_epi32( 0x20 ),
+        _mm256_cmpgt_epi32( _mm256_set1_epi32( -0x7fffffff - 1 + 26 ), _mm256_add_epi32( x, _mm256_set1_epi32( 0x7fffffff - 'A' + 1 ) ) ) ) ); }
 #endif
+};
 
-    // 24.4.2.2 Iterator support:
+template< typename CharT >
+inline __m128i load128( CharT const * s )
+{
+    return _mm_loadu_si128( reinterpret_cast<__m128i const *>( s ) );
+}
 
-    nssv_constexpr const_iterator begin()  const nssv_noexcept { return data_;         }
-    nssv_constexpr const_iterator end()    const nssv_noexcept { return data_ + size_; }
+inline unsigned movemask( __m128i m )
+{
+    return static_cast<unsigned>( _mm_movemask_epi8( m ) );
+}
 
-    nssv_constexpr const_iterator cbegin() const nssv_noexcept { return begin(); }
-    nssv_constexpr const_iterator cend()   const nssv_noexcept { return end();   }
+#if nssv_HAVE_AVX2
 
-    nssv_constexpr const_reverse_iterator rbegin()  const nssv_noexcept { return const_reverse_iterator( end() );   }
-    nssv_constexpr const_reverse_iterator rend()    const nssv_noexcept { return const_reverse_iterator( begin() ); }
+template< typename CharT >
+inline __m256i load256( CharT const * s )
+{
+    return _mm256_loadu_si256( reinterpret_cast<__m256i const *>( s ) );
+}
 
-    nssv_constexpr const_reverse_iterator crbegin() const nssv_noexcept { return rbegin(); }
-    nssv_constexpr const_reverse_iterator crend()   const nssv_noexcept { return rend();   }
+inline unsigned movemask( __m256i m )
+{
+    return static_cast<unsigned>( _mm256_movemask_epi8( m ) );
+}
 
-    // 24.4.2.3 Capacity:
+#endif // nssv_HAVE_AVX2
 
-    nssv_constexpr size_type size()     const nssv_noexcept { return size_; }
-    nssv_constexpr size_type length()   const nssv_noexcept { return size_; }
-    nssv_constexpr size_type max_size() const nssv_noexcept { return (std::numeric_limits< size_type >::max)(); }
+// index of first character c in [s, s + n), compare 64 bytes per iteration:
 
-    // since C++20
-    nssv_nodiscard nssv_constexpr bool empty() const nssv_noexcept
-    {
-        return 0 == size_;
-    }
+template< typename CharT >
+std::size_t find_char_simd( CharT const * s, std::size_t n, CharT c )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-    // 24.4.2.4 Element access:
+    const std::size_t lane  = sizeof(CharT);
+    std::size_t i = 0;
 
-    nssv_constexpr const_reference operator[]( size_type pos ) const
+#if nssv_HAVE_AVX2
+    const std::size_t step = 32 / lane;
+    const __m256i needle = lanes::splat256( c );
+
+    for ( ; i + 2 * step <= n; i += 2 * step )
     {
-        return data_at( pos );
+        const __m256i m0 = lanes::eq( load256( s + i        ), needle );
+        const __m256i m1 = lanes::eq( load256( s + i + step ), needle );
+
+        if ( movemask( _mm256_or_si256( m0, m1 ) ) != 0 )
+        {
+            const unsigned k0 = movemask( m0 );
+            return k0 != 0 ? i + ctz( k0 ) / lane : i + step + ctz( movemask( m1 ) ) / lane;
+        }
     }
+#else
+    const std::size_t step = 16 / lane;
+    const __m128i needle = lanes::splat( c );
 
-    nssv_constexpr14 const_reference at( size_type pos ) const
+    for ( ; i + 4 * step <= n; i += 4 * step )
     {
-#if nssv_CONFIG_NO_EXCEPTIONS
-        assert( pos < size() );
-#else
-        if ( pos >= size() )
+        const __m128i m0 = lanes::eq( load128( s + i            ), needle );
+        const __m128i m1 = lanes::eq( load128( s + i +     step ), needle );
+        const __m128i m2 = lanes::eq( load128( s + i + 2 * step ), needle );
+        const __m128i m3 = lanes::eq( load128( s + i + 3 * step ), needle );
+
+        if ( movemask( _mm_or_si128( _mm_or_si128( m0, m1 ), _mm_or_si128( m2, m3 ) ) ) != 0 )
         {
-            throw std::out_of_range("nonstd::string_view::at()");
+            break;
         }
-#endif
-        return data_at( pos );
     }
+#endif
+    {
+        const std::size_t step16 = 16 / lane;
+        const __m128i needle16 = lanes::splat( c );
 
-    nssv_constexpr const_reference front() const { return data_at( 0 );          }
-    nssv_constexpr const_reference back()  const { return data_at( size() - 1 ); }
+        for ( ; i + step16 <= n; i += step16 )
+        {
+            const unsigned k = movemask( lanes::eq( load128( s + i ), needle16 ) );
 
-    nssv_constexpr const_pointer   data()  const nssv_noexcept { return data_; }
+            if ( k != 0 )
+            {
+                return i + ctz( k ) / lane;
+            }
+        }
+    }
 
-    // 24.4.2.5 Modifiers:
-
-    nssv_constexpr14 void remove_prefix( size_type n )
+    for ( ; i < n; ++i )
     {
-        assert( n <= size() );
-        data_ += n;
-        size_ -= n;
+        if ( s[i] == c )
+        {
+            return i;
+        }
     }
+    return npos;
+}
 
-    nssv_constexpr14 void remove_suffix( size_type n )
-    {
-        assert( n <= size() );
-        size_ -= n;
-    }
+// index of last character c in [s, s + n), scanning backwards:
 
-    nssv_constexpr14 void swap( basic_string_view & other ) nssv_noexcept
-    {
-        const basic_string_view tmp(other);
-        other = *this;
-        *this = tmp;
-    }
+template< typename CharT >
+std::size_t rfind_char_simd( CharT const * s, std::size_t n, CharT c )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-    // 24.4.2.6 String operations:
+    const std::size_t lane = sizeof(CharT);
+    std::size_t i = n;
 
-    size_type copy( CharT * dest, size_type n, size_type pos = 0 ) const
+#if nssv_HAVE_AVX2
+    const std::size_t step = 32 / lane;
+    const __m256i needle = lanes::splat256( c );
+
+    for ( ; i >= 2 * step; i -= 2 * step )
     {
-#if nssv_CONFIG_NO_EXCEPTIONS
-        assert( pos <= size() );
+        const __m256i m0 = lanes::eq( load256( s + i - 2 * step ), needle );
+        const __m256i m1 = lanes::eq( load256( s + i -     step ), needle );
+
+        if ( movemask( _mm256_or_si256( m0, m1 ) ) != 0 )
+        {
+            const unsigned k1 = movemask( m1 );
+            return k1 != 0 ? i - step + bsr( k1 ) / lane : i - 2 * step + bsr( movemask( m0 ) ) / lane;
+        }
+    }
 #else
-        if ( pos > size() )
+    const std::size_t step = 16 / lane;
+    const __m128i needle = lanes::splat( c );
+
+    for ( ; i >= 4 * step; i -= 4 * step )
+    {
+        const __m128i m0 = lanes::eq( load128( s + i - 4 * step ), needle );
+        const __m128i m1 = lanes::eq( load128( s + i - 3 * step ), needle );
+        const __m128i m2 = lanes::eq( load128( s + i - 2 * step ), needle );
+        const __m128i m3 = lanes::eq( load128( s + i -     step ), needle );
+
+        if ( movemask( _mm_or_si128( _mm_or_si128( m0, m1 ), _mm_or_si128( m2, m3 ) ) ) != 0 )
         {
-            throw std::out_of_range("nonstd::string_view::copy()");
+            break;
         }
+    }
 #endif
-        const size_type rlen = (std::min)( n, size() - pos );
+    {
+        const std::size_t step16 = 16 / lane;
+        const __m128i needle16 = lanes::splat( c );
 
-        (void) Traits::copy( dest, data() + pos, rlen );
+        for ( ; i >= step16; i -= step16 )
+        {
+            const unsigned k = movemask( lanes::eq( load128( s + i - step16 ), needle16 ) );
 
-        return rlen;
+            if ( k != 0 )
+            {
+                return i - step16 + bsr( k ) / lane;
+            }
+        }
     }
 
-    nssv_constexpr14 basic_string_view substr( size_type pos = 0, size_type n = npos ) const
+    while ( i-- != 0 )
     {
-#if nssv_CONFIG_NO_EXCEPTIONS
-        assert( pos <= size() );
-#else
-        if ( pos > size() )
+        if ( s[i] == c )
         {
-            throw std::out_of_range("nonstd::string_view::substr()");
+            return i;
         }
-#endif
-        return basic_string_view( data() + pos, (std::min)( n, size() - pos ) );
     }
+    return npos;
+}
 
-    // compare(), 6x:
+// number of characters c in [s, s + n): a matching lane adds one to each
+// of its bytes in byte-wide counters, that are summed before they overflow:
 
-    nssv_constexpr14 int compare( basic_string_view other ) const nssv_noexcept // (1)
-    {
-#if nssv_CPP17_OR_GREATER
-        if ( const int result = Traits::compare( data(), other.data(), (std::min)( size(), other.size() ) ) )
-#else
-        if ( const int result = detail::compare( data(), other.data(), (std::min)( size(), other.size() ) ) )
+inline std::size_t sum_quads( __m128i sum )
+{
+    return static_cast<std::size_t>( _mm_cvtsi128_si32( _mm_add_epi64( sum, _mm_unpackhi_epi64( sum, sum ) ) ) );
+}
+
+inline std::size_t sum_bytes( __m128i acc )
+{
+    return sum_quads( _mm_sad_epu8( acc, _mm_setzero_si128() ) );
+}
+
+#if nssv_HAVE_AVX2
+inline std::size_t sum_bytes( __m256i acc )
+{
+    const __m256i sum = _mm256_sad_epu8( acc, _mm256_setzero_si256() );
+    return sum_quads( _mm_add_epi64( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) ) );
+}
 #endif
-        {
-            return result;
-        }
 
-        return size() == other.size() ? 0 : size() < other.size() ? -1 : 1;
-    }
+template< typename CharT >
+std::size_t count_char_simd( CharT const * s, std::size_t n, CharT c )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-    nssv_constexpr int compare( size_type pos1, size_type n1, basic_string_view other ) const // (2)
-    {
-        return substr( pos1, n1 ).compare( other );
-    }
+    const std::size_t lane  = sizeof(CharT);
+    std::size_t bytes = 0;
+    std::size_t i = 0;
 
-    nssv_constexpr int compare( size_type pos1, size_type n1, basic_string_view other, size_type pos2, size_type n2 ) const // (3)
-    {
-        return substr( pos1, n1 ).compare( other.substr( pos2, n2 ) );
-    }
+#if nssv_HAVE_AVX2
+    const std::size_t step = 32 / lane;
+    const __m256i needle = lanes::splat256( c );
 
-    nssv_constexpr int compare( CharT const * s ) const // (4)
+    while ( i + step <= n )
     {
-        return compare( basic_string_view( s ) );
-    }
+        __m256i acc = _mm256_setzero_si256();
 
-    nssv_constexpr int compare( size_type pos1, size_type n1, CharT const * s ) const // (5)
+        for ( unsigned k = 0; k != 255 && i + step <= n; ++k, i += step )
+        {
+            acc = _mm256_sub_epi8( acc, lanes::eq( load256( s + i ), needle ) );
+        }
+        bytes += sum_bytes( acc );
+    }
+#endif
     {
-        return substr( pos1, n1 ).compare( basic_string_view( s ) );
+        const std::size_t step16 = 16 / lane;
+        const __m128i needle16 = lanes::splat( c );
+
+        while ( i + step16 <= n )
+        {
+            __m128i acc = _mm_setzero_si128();
+
+            for ( unsigned k = 0; k != 255 && i + step16 <= n; ++k, i += step16 )
+            {
+                acc = _mm_sub_epi8( acc, lanes::eq( load128( s + i ), needle16 ) );
+            }
+            bytes += sum_bytes( acc );
+        }
     }
 
-    nssv_constexpr int compare( size_type pos1, size_type n1, CharT const * s, size_type n2 ) const // (6)
+    std::size_t result = bytes / lane;
+
+    for ( ; i < n; ++i )
     {
-        return substr( pos1, n1 ).compare( basic_string_view( s, n2 ) );
+        result += s[i] == c;
     }
+    return result;
+}
 
-    // 24.4.2.7 Searching:
+// length of s, a multiple of sizeof(CharT) away from 16-byte alignment;
+// compare aligned blocks of 16 bytes, ignoring the bytes before s:
 
-    // starts_with(), 3x, since C++20:
+template< typename CharT >
+nssv_NO_SANITIZE_ADDRESS
+std::size_t length_simd( CharT const * s )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-    nssv_constexpr bool starts_with( basic_string_view v ) const nssv_noexcept  // (1)
-    {
-        return size() >= v.size() && compare( 0, v.size(), v ) == 0;
-    }
+    const std::size_t lane   = sizeof(CharT);
+    const std::size_t step   = 16 / lane;
+    const std::size_t offset = static_cast<std::size_t>( reinterpret_cast<std::ptrdiff_t>( s ) & 15 );
+    const __m128i     zero   = _mm_setzero_si128();
 
-    nssv_constexpr bool starts_with( CharT c ) const nssv_noexcept  // (2)
+    CharT const * p = s - offset / lane;
+
+    unsigned k = movemask( lanes::eq( _mm_load_si128( reinterpret_cast<__m128i const *>( p ) ), zero ) ) >> offset;
+
+    if ( k != 0 )
     {
-        return starts_with( basic_string_view( &c, 1 ) );
+        return ctz( k ) / lane;
     }
 
-    nssv_constexpr bool starts_with( CharT const * s ) const  // (3)
+    for ( ;; )
     {
-        return starts_with( basic_string_view( s ) );
+        p += step;
+        k = movemask( lanes::eq( _mm_load_si128( reinterpret_cast<__m128i const *>( p ) ), zero ) );
+
+        if ( k != 0 )
+        {
+            return static_cast<std::size_t>( p - s ) + ctz( k ) / lane;
+        }
     }
+}
 
-    // ends_with(), 3x, since C++20:
+#endif // nssv_HAVE_SSE2
 
-    nssv_constexpr bool ends_with( basic_string_view v ) const nssv_noexcept  // (1)
-    {
-        return size() >= v.size() && compare( size() - v.size(), npos, v ) == 0;
-    }
+// index of first character c in [s, s + n), or npos:
 
-    nssv_constexpr bool ends_with( CharT c ) const nssv_noexcept  // (2)
+template< class Traits, typename CharT >
+inline std::size_t find_char( CharT const * s, std::size_t n, CharT c, false_type /*simd*/ )
+{
+    CharT const * p = Traits::find( s, n, c );
+    return p ? static_cast<std::size_t>( p - s ) : npos;
+}
+
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t find_char( CharT const * s, std::size_t n, CharT c, true_type /*simd*/ )
+{
+    return find_char_simd( s, n, c );
+}
+#endif
+
+template< class Traits, typename CharT >
+inline std::size_t find_char( CharT const * s, std::size_t n, CharT c )
+{
+    return find_char<Traits>( s, n, c, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// index of last character c in [s, s + n), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t rfind_char( CharT const * s, std::size_t n, CharT c, false_type /*simd*/ )
+{
+    while ( n-- != 0 )
     {
-        return ends_with( basic_string_view( &c, 1 ) );
+        if ( Traits::eq( s[n], c ) )
+        {
+            return n;
+        }
     }
+    return npos;
+}
 
-    nssv_constexpr bool ends_with( CharT const * s ) const  // (3)
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t rfind_char( CharT const * s, std::size_t n, CharT c, true_type /*simd*/ )
+{
+    return rfind_char_simd( s, n, c );
+}
+#endif
+
+template< class Traits, typename CharT >
+inline std::size_t rfind_char( CharT const * s, std::size_t n, CharT c )
+{
+    return rfind_char<Traits>( s, n, c, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// number of characters c in [s, s + n):
+
+template< class Traits, typename CharT >
+inline std::size_t count_char( CharT const * s, std::size_t n, CharT c, false_type /*simd*/ )
+{
+    std::size_t result = 0;
+
+    for ( std::size_t i = 0; i != n; ++i )
     {
-        return ends_with( basic_string_view( s ) );
+        result += Traits::eq( s[i], c );
     }
+    return result;
+}
 
-    // find(), 4x:
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t count_char( CharT const * s, std::size_t n, CharT c, true_type /*simd*/ )
+{
+    return count_char_simd( s, n, c );
+}
+#endif
 
-    nssv_constexpr14 size_type find( basic_string_view v, size_type pos = 0 ) const nssv_noexcept  // (1)
-    {
-        return assert( v.size() == 0 || v.data() != nssv_nullptr )
-            , pos >= size()
-            ? npos : to_pos(
-#if nssv_CPP11_OR_GREATER && ! nssv_CPP17_OR_GREATER
-                detail::search( substr(pos), v )
-#else
-                std::search( cbegin() + pos, cend(), v.cbegin(), v.cend(), Traits::eq )
+template< class Traits, typename CharT >
+inline std::size_t count_char( CharT const * s, std::size_t n, CharT c )
+{
+    return count_char<Traits>( s, n, c, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// length of s; besides strlen() for char and wcslen() for wchar_t,
+// SSE2 for char16_t and char32_t:
+
+template< typename CharT >
+inline std::size_t length_runtime( CharT const * s, false_type /*simd*/ )
+{
+    return length_loop( s );
+}
+
+#if nssv_HAVE_SSE2
+template< typename CharT >
+inline std::size_t length_runtime( CharT const * s, true_type /*simd*/ )
+{
+    return reinterpret_cast<std::ptrdiff_t>( s ) % static_cast<std::ptrdiff_t>( sizeof(CharT) ) == 0
+        ? length_simd( s )
+        : length_loop( s );
+}
 #endif
-            );
-    }
 
-    nssv_constexpr size_type find( CharT c, size_type pos = 0 ) const nssv_noexcept  // (2)
-    {
-        return find( basic_string_view( &c, 1 ), pos );
-    }
+template< typename CharT >
+std::size_t length_runtime( CharT const * s )
+{
+    return length_runtime( s, bool_constant< use_simd<CharT, std::char_traits<CharT> >::value >() );
+}
 
-    nssv_constexpr size_type find( CharT const * s, size_type pos, size_type n ) const  // (3)
-    {
-        return find( basic_string_view( s, n ), pos );
-    }
+// Two-Way string matching, Crochemore and Perrin, 1991:
+// linear time in the worst case, constant space. It is a pointer,
+// or a reversed_ptr for searching backwards.
 
-    nssv_constexpr size_type find( CharT const * s, size_type pos = 0 ) const  // (4)
-    {
-        return find( basic_string_view( s ), pos );
-    }
+// view [last - n, last) in reverse via operator[], + and ++:
 
-    // rfind(), 4x:
+template< typename CharT >
+class reversed_ptr
+{
+public:
+    explicit reversed_ptr( CharT const * last ) : last_( last ) {}
 
-    nssv_constexpr14 size_type rfind( basic_string_view v, size_type pos = npos ) const nssv_noexcept  // (1)
+    CharT operator[]( std::size_t i ) const { return *( last_ - 1 - i ); }
+    CharT operator* (               ) const { return *( last_ - 1     ); }
+
+    reversed_ptr   operator+( std::size_t i ) const { return reversed_ptr( last_ - i ); }
+    reversed_ptr & operator++() { --last_; return *this; }
+
+private:
+    CharT const * last_;
+};
+
+template< class Traits, class It >
+bool equal_n( It a, It b, std::size_t n )
+{
+    for ( ; n != 0; --n, ++a, ++b )
     {
-        if ( size() < v.size() )
+        if ( ! Traits::eq( *a, *b ) )
         {
-            return npos;
+            return false;
         }
+    }
+    return true;
+}
 
-        if ( v.empty() )
-        {
-            return (std::min)( size(), pos );
-        }
+// critical factorization of needle [p, p + m), m > 0, yields the
+// start of the right half, and the period of the right half:
 
-        const_iterator last   = cbegin() + (std::min)( size() - v.size(), pos ) + v.size();
-        const_iterator result = std::find_end( cbegin(), last, v.cbegin(), v.cend(), Traits::eq );
+template< class Traits, class It >
+std::size_t critical_factorization( It p, std::size_t m, std::size_t & period )
+{
+    // maximal suffix for order lt(), then for its reverse; note that
+    // max_suffix starts out at 'index -1' and relies on wrap-around:
 
-        return result != last ? size_type( result - cbegin() ) : npos;
-    }
+    std::size_t max_suffix = npos, j = 0, k = 1, q = 1;
 
-    nssv_constexpr14 size_type rfind( CharT c, size_type pos = npos ) const nssv_noexcept  // (2)
+    while ( j + k < m )
     {
-        return rfind( basic_string_view( &c, 1 ), pos );
+        if      ( Traits::lt( p[j + k], p[max_suffix + k] ) ) { j += k; k = 1; q = j - max_suffix; }
+        else if ( Traits::eq( p[j + k], p[max_suffix + k] ) ) { if ( k != q ) { ++k; } else { j += q; k = 1; } }
+        else                                                  { max_suffix = j++; k = q = 1; }
     }
+    period = q;
 
-    nssv_constexpr14 size_type rfind( CharT const * s, size_type pos, size_type n ) const  // (3)
+    std::size_t max_suffix_rev = npos;
+    j = 0; k = q = 1;
+
+    while ( j + k < m )
     {
-        return rfind( basic_string_view( s, n ), pos );
+        if      ( Traits::lt( p[max_suffix_rev + k], p[j + k] ) ) { j += k; k = 1; q = j - max_suffix_rev; }
+        else if ( Traits::eq( p[max_suffix_rev + k], p[j + k] ) ) { if ( k != q ) { ++k; } else { j += q; k = 1; } }
+        else                                                      { max_suffix_rev = j++; k = q = 1; }
     }
 
-    nssv_constexpr14 size_type rfind( CharT const * s, size_type pos = npos ) const  // (4)
+    if ( max_suffix_rev + 1 < max_suffix + 1 )
     {
-        return rfind( basic_string_view( s ), pos );
+        return max_suffix + 1;
     }
+    period = q;
+    return max_suffix_rev + 1;
+}
 
-    // find_first_of(), 4x:
+// index of first occurrence of needle [p, p + m) in [s, s + n), 0 < m <= n,
+// given the needle's critical factorization. For a periodic needle, memory
+// is the length of its prefix that is known to match at s:
 
-    nssv_constexpr size_type find_first_of( basic_string_view v, size_type pos = 0 ) const nssv_noexcept  // (1)
+template< class Traits, class It >
+std::size_t two_way_search( It s, std::size_t n, It p, std::size_t m, std::size_t suffix, std::size_t period, std::size_t memory = 0 )
+{
+    if ( equal_n<Traits>( p, p + period, suffix ) )
     {
-        return pos >= size()
-            ? npos
-            : to_pos( std::find_first_of( cbegin() + pos, cend(), v.cbegin(), v.cend(), Traits::eq ) );
-    }
+        // periodic needle, remember the matched prefix of the period:
 
-    nssv_constexpr size_type find_first_of( CharT c, size_type pos = 0 ) const nssv_noexcept  // (2)
-    {
-        return find_first_of( basic_string_view( &c, 1 ), pos );
+        for ( std::size_t j = 0; j <= n - m; )
+        {
+            std::size_t i = (std::max)( suffix, memory );
+
+            while ( i < m && Traits::eq( p[i], s[i + j] ) )
+            {
+                ++i;
+            }
+            if ( m <= i )
+            {
+                i = suffix - 1;
+                while ( memory < i + 1 && Traits::eq( p[i], s[i + j] ) )
+                {
+                    --i;
+                }
+                if ( i + 1 < memory + 1 )
+                {
+                    return j;
+                }
+                j += period;
+                memory = m - period;
+            }
+            else
+            {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
     }
-
-    nssv_constexpr size_type find_first_of( CharT const * s, size_type pos, size_type n ) const  // (3)
+    else
     {
-        return find_first_of( basic_string_view( s, n ), pos );
-    }
+        // non-periodic needle, shift beyond the longest half:
 
-    nssv_constexpr size_type find_first_of(  CharT const * s, size_type pos = 0 ) const  // (4)
-    {
-        return find_first_of( basic_string_view( s ), pos );
+        period = (std::max)( suffix, m - suffix ) + 1;
+
+        for ( std::size_t j = 0; j <= n - m; )
+        {
+            std::size_t i = suffix;
+
+            while ( i < m && Traits::eq( p[i], s[i + j] ) )
+            {
+                ++i;
+            }
+            if ( m <= i )
+            {
+                i = suffix - 1;
+                while ( i != npos && Traits::eq( p[i], s[i + j] ) )
+                {
+                    --i;
+                }
+                if ( i == npos )
+                {
+                    return j;
+                }
+                j += period;
+            }
+            else
+            {
+                j += i - suffix + 1;
+            }
+        }
     }
+    return npos;
+}
 
-    // find_last_of(), 4x:
+template< class Traits, class It >
+std::size_t two_way_search( It s, std::size_t n, It p, std::size_t m )
+{
+    std::size_t period = 0;
+    const std::size_t suffix = critical_factorization<Traits>( p, m, period );
 
-    nssv_constexpr size_type find_last_of( basic_string_view v, size_type pos = npos ) const nssv_noexcept  // (1)
-    {
-        return empty()
-            ? npos
-            : pos >= size()
-            ? find_last_of( v, size() - 1 )
-            : to_pos( std::find_first_of( const_reverse_iterator( cbegin() + pos + 1 ), crend(), v.cbegin(), v.cend(), Traits::eq ) );
-    }
+    return two_way_search<Traits>( s, n, p, m, suffix, period );
+}
 
-    nssv_constexpr size_type find_last_of( CharT c, size_type pos = npos ) const nssv_noexcept  // (2)
-    {
-        return find_last_of( basic_string_view( &c, 1 ), pos );
-    }
+// index of last occurrence of needle [p, p + m) in [s, s + n), 0 < m <= n:
 
-    nssv_constexpr size_type find_last_of( CharT const * s, size_type pos, size_type count ) const  // (3)
-    {
-        return find_last_of( basic_string_view( s, count ), pos );
-    }
+template< class Traits, typename CharT >
+std::size_t two_way_rsearch( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    const std::size_t j = two_way_search<Traits>( reversed_ptr<CharT>( s + n ), n, reversed_ptr<CharT>( p + m ), m );
 
-    nssv_constexpr size_type find_last_of( CharT const * s, size_type pos = npos ) const  // (4)
-    {
-        return find_last_of( basic_string_view( s ), pos );
-    }
+    return j == npos ? npos : n - m - j;
+}
 
-    // find_first_not_of(), 4x:
+#if nssv_HAVE_SSE2
 
-    nssv_constexpr size_type find_first_not_of( basic_string_view v, size_type pos = 0 ) const nssv_noexcept  // (1)
-    {
-        return pos >= size()
-            ? npos
-            : to_pos( std::find_if( cbegin() + pos, cend(), not_in_view( v ) ) );
-    }
+// SIMD filter for the needle's first and last character, verify candidates
+// via Traits::compare(); 1 < m <= n. Verification work is added to work,
+// and scanned is the length scanned before s by earlier calls. Once the work
+// exceeds a multiple of the scanned length, set two_way and yield the index
+// to continue from with Two-Way, to keep the worst case linear:
 
-    nssv_constexpr size_type find_first_not_of( CharT c, size_type pos = 0 ) const nssv_noexcept  // (2)
-    {
-        return find_first_not_of( basic_string_view( &c, 1 ), pos );
-    }
+template< class Traits, typename CharT >
+std::size_t search_simd( CharT const * s, std::size_t n, CharT const * p, std::size_t m, std::size_t scanned, std::size_t & work, bool & two_way )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-    nssv_constexpr size_type find_first_not_of( CharT const * s, size_type pos, size_type count ) const  // (3)
-    {
-        return find_first_not_of( basic_string_view( s, count ), pos );
-    }
+    const std::size_t lane  = sizeof(CharT);
+    const std::size_t step  = 32 / lane;
+    const unsigned    group = ( 1u << lane ) - 1u;
 
-    nssv_constexpr size_type find_first_not_of( CharT const * s, size_type pos = 0 ) const  // (4)
-    {
-        return find_first_not_of( basic_string_view( s ), pos );
-    }
+#if nssv_HAVE_AVX2
+    const __m256i first = lanes::splat256( p[0] );
+    const __m256i last  = lanes::splat256( p[m - 1] );
+#else
+    const __m128i first = lanes::splat( p[0] );
+    const __m128i last  = lanes::splat( p[m - 1] );
+#endif
 
-    // find_last_not_of(), 4x:
+    std::size_t i = 0;
 
-    nssv_constexpr size_type find_last_not_of( basic_string_view v, size_type pos = npos ) const nssv_noexcept  // (1)
+    for ( ; i + step + m - 1 <= n; i += step )
     {
-        return empty()
-            ? npos
-            : pos >= size()
-            ? find_last_not_of( v, size() - 1 )
-            : to_pos( std::find_if( const_reverse_iterator( cbegin() + pos + 1 ), crend(), not_in_view( v ) ) );
-    }
+#if nssv_HAVE_AVX2
+        unsigned k = movemask( _mm256_and_si256(
+            lanes::eq( first, load256( s + i         ) ),
+            lanes::eq( last , load256( s + i + m - 1 ) ) ) );
+#else
+        unsigned k = movemask( _mm_and_si128(
+            lanes::eq( first, load128( s + i         ) ),
+            lanes::eq( last , load128( s + i + m - 1 ) ) ) )
+            | movemask( _mm_and_si128(
+            lanes::eq( first, load128( s + i + step / 2         ) ),
+            lanes::eq( last , load128( s + i + step / 2 + m - 1 ) ) ) ) << 16;
+#endif
 
-    nssv_constexpr size_type find_last_not_of( CharT c, size_type pos = npos ) const nssv_noexcept  // (2)
-    {
-        return find_last_not_of( basic_string_view( &c, 1 ), pos );
-    }
+        while ( k != 0 )
+        {
+            const unsigned bit = ctz( k );
+            const std::size_t idx = i + bit / lane;
 
-    nssv_constexpr size_type find_last_not_of( CharT const * s, size_type pos, size_type count ) const  // (3)
-    {
-        return find_last_not_of( basic_string_view( s, count ), pos );
+            work += m;
+
+            if ( Traits::compare( s + idx + 1, p + 1, m - 2 ) == 0 )
+            {
+                return idx;
+            }
+            k &= ~( group << bit );
+        }
+
+        if ( work > 8 * ( scanned + i ) + 1024 )
+        {
+            two_way = true;
+            return i;
+        }
     }
 
-    nssv_constexpr size_type find_last_not_of( CharT const * s, size_type pos = npos ) const  // (4)
+    // fewer than step candidate positions remain:
+
+    for ( ; i + m <= n; ++i )
     {
-        return find_last_not_of( basic_string_view( s ), pos );
+        if ( Traits::eq( s[i], p[0] ) && Traits::compare( s + i + 1, p + 1, m - 1 ) == 0 )
+        {
+            return i;
+        }
     }
+    return npos;
+}
 
-    // Constants:
+template< class Traits, typename CharT >
+std::size_t search_simd( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    std::size_t work = 0;
+    bool two_way = false;
 
-#if nssv_CPP17_OR_GREATER
-    static nssv_constexpr size_type npos = size_type(-1);
-#elif nssv_CPP11_OR_GREATER
-    enum : size_type { npos = size_type(-1) };
+    const std::size_t i = search_simd<Traits>( s, n, p, m, 0, work, two_way );
+
+    return two_way ? add_pos( i, two_way_search<Traits>( s + i, n - i, p, m ) ) : i;
+}
+
+// as search_simd(), scanning backwards for the last occurrence:
+
+template< class Traits, typename CharT >
+std::size_t rsearch_simd( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
+
+    const std::size_t lane  = sizeof(CharT);
+    const std::size_t step  = 32 / lane;
+    const unsigned    group = ( 1u << lane ) - 1u;
+
+#if nssv_HAVE_AVX2
+    const __m256i first = lanes::splat256( p[0] );
+    const __m256i last  = lanes::splat256( p[m - 1] );
 #else
-    enum { npos = size_type(-1) };
+    const __m128i first = lanes::splat( p[0] );
+    const __m128i last  = lanes::splat( p[m - 1] );
 #endif
 
-private:
-    struct not_in_view
-    {
-        const basic_string_view v;
+    // candidate positions [0, i) remain:
 
-        nssv_constexpr explicit not_in_view( basic_string_view v_ ) : v( v_ ) {}
+    const std::size_t candidates = n - m + 1;
+    std::size_t i = candidates;
+    std::size_t work = 0;
+
+    for ( ; i >= step; i -= step )
+    {
+        const std::size_t b = i - step;
+#if nssv_HAVE_AVX2
+        unsigned k = movemask( _mm256_and_si256(
+            lanes::eq( first, load256( s + b         ) ),
+            lanes::eq( last , load256( s + b + m - 1 ) ) ) );
+#else
+        unsigned k = movemask( _mm_and_si128(
+            lanes::eq( first, load128( s + b         ) ),
+            lanes::eq( last , load128( s + b + m - 1 ) ) ) )
+            | movemask( _mm_and_si128(
+            lanes::eq( first, load128( s + b + step / 2         ) ),
+            lanes::eq( last , load128( s + b + step / 2 + m - 1 ) ) ) ) << 16;
+#endif
 
-        nssv_constexpr bool operator()( CharT c ) const
+        while ( k != 0 )
         {
-            return npos == v.find_first_of( c );
+            const unsigned at = bsr( k ) / lane;
+            const std::size_t idx = b + at;
+
+            if ( Traits::compare( s + idx + 1, p + 1, m - 2 ) == 0 )
+            {
+                return idx;
+            }
+            work += m;
+            k &= ~( group << ( at * lane ) );
         }
-    };
 
-    nssv_constexpr size_type to_pos( const_iterator it ) const
-    {
-        return it == cend() ? npos : size_type( it - cbegin() );
+        if ( work > 8 * ( candidates - b ) + 1024 )
+        {
+            return b == 0 ? npos : two_way_rsearch<Traits>( s, b + m - 1, p, m );
+        }
     }
 
-    nssv_constexpr size_type to_pos( const_reverse_iterator it ) const
+    // fewer than step candidate positions remain:
+
+    while ( i-- != 0 )
     {
-        return it == crend() ? npos : size_type( crend() - it - 1 );
+        if ( Traits::eq( s[i], p[0] ) && Traits::compare( s + i + 1, p + 1, m - 1 ) == 0 )
+        {
+            return i;
+        }
     }
+    return npos;
+}
 
-    nssv_constexpr const_reference data_at( size_type pos ) const
-    {
-#if nssv_BETWEEN( nssv_COMPILER_GNUC_VERSION, 1, 500 )
-        return data_[pos];
-#else
-        return assert( pos < size() ), data_[pos];
+#endif // nssv_HAVE_SSE2
+
+template< class Traits, typename CharT >
+inline std::size_t find_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m, false_type /*simd*/ )
+{
+    return two_way_search<Traits>( s, n, p, m );
+}
+
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t find_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m, true_type /*simd*/ )
+{
+    return search_simd<Traits>( s, n, p, m );
+}
 #endif
-    }
 
-private:
-    const_pointer data_;
-    size_type     size_;
+// index of first occurrence of needle [p, p + m) in [s, s + n), or npos:
 
-public:
-#if nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
+template< class Traits, typename CharT >
+inline std::size_t find_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? 0
+        :  m >  n ? npos
+        :  m == 1 ? find_char<Traits>( s, n, p[0] )
+        :  find_string<Traits>( s, n, p, m, bool_constant< use_simd<CharT, Traits>::value >() );
+}
 
-    template< class Allocator >
-    basic_string_view( std::basic_string<CharT, Traits, Allocator> const & s ) nssv_noexcept
-        : data_( s.data() )
-        , size_( s.size() )
+template< class Traits, typename CharT >
+inline std::size_t rfind_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m, false_type /*simd*/ )
+{
+    return two_way_rsearch<Traits>( s, n, p, m );
+}
+
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t rfind_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m, true_type /*simd*/ )
+{
+    return rsearch_simd<Traits>( s, n, p, m );
+}
+#endif
+
+// index of last occurrence of needle [p, p + m) in [s, s + n), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t rfind_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? n
+        :  m >  n ? npos
+        :  m == 1 ? rfind_char<Traits>( s, n, p[0] )
+        :  rfind_string<Traits>( s, n, p, m, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// search state carried from one occurrence to the next, to enumerate the
+// occurrences of a needle in linear time: the verification work of the
+// SIMD filter, whether it switched to Two-Way, and the memory of Two-Way:
+
+struct search_state
+{
+    std::size_t work;
+    std::size_t memory;
+    bool two_way;
+
+    explicit search_state( bool simd )
+        : work( 0 )
+        , memory( 0 )
+        , two_way( ! simd )
     {}
+};
 
-#if nssv_HAVE_EXPLICIT_CONVERSION
+// as find_string() for 1 < m <= n, given the needle's critical factorization,
+// at index scanned of the text being enumerated:
 
-    template< class Allocator >
-    explicit operator std::basic_string<CharT, Traits, Allocator>() const
+template< class Traits, typename CharT >
+inline std::size_t resume_search( CharT const * s, std::size_t n, CharT const * p, std::size_t m, std::size_t suffix, std::size_t period, std::size_t /*scanned*/, search_state & st, false_type /*simd*/ )
+{
+    return two_way_search<Traits>( s, n, p, m, suffix, period, st.memory );
+}
+
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t resume_search( CharT const * s, std::size_t n, CharT const * p, std::size_t m, std::size_t suffix, std::size_t period, std::size_t scanned, search_state & st, true_type /*simd*/ )
+{
+    if ( st.two_way )
     {
-        return to_string( Allocator() );
+        return two_way_search<Traits>( s, n, p, m, suffix, period, st.memory );
     }
 
-#endif // nssv_HAVE_EXPLICIT_CONVERSION
+    const std::size_t i = search_simd<Traits>( s, n, p, m, scanned, st.work, st.two_way );
 
-#if nssv_CPP11_OR_GREATER
+    return st.two_way ? add_pos( i, two_way_search<Traits>( s + i, n - i, p, m, suffix, period ) ) : i;
+}
+#endif
 
-    template< class Allocator = std::allocator<CharT> >
-    std::basic_string<CharT, Traits, Allocator>
-    to_string( Allocator const & a = Allocator() ) const
+template< class Traits, typename CharT >
+inline std::size_t resume_search( CharT const * s, std::size_t n, CharT const * p, std::size_t m, std::size_t suffix, std::size_t period, std::size_t scanned, search_state & st )
+{
+    return resume_search<Traits>( s, n, p, m, suffix, period, scanned, st, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// number of non-overlapping occurrences of needle [p, p + m) in [s, s + n),
+// an empty needle occurs at each index:
+
+template< class Traits, typename CharT >
+std::size_t count_string( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    if ( m == 0 ) return n;
+    if ( m == 1 ) return count_char<Traits>( s, n, p[0] );
+
+    std::size_t period = 0;
+    const std::size_t suffix = critical_factorization<Traits>( p, m, period );
+
+    search_state st( use_simd<CharT, Traits>::value );
+    std::size_t result = 0;
+
+    for ( std::size_t j = 0; m <= n - j; ++result )
     {
-        return std::basic_string<CharT, Traits, Allocator>( begin(), end(), a );
+        const std::size_t i = resume_search<Traits>( s + j, n - j, p, m, suffix, period, j, st );
+
+        if ( i == npos )
+        {
+            break;
+        }
+        j += i + m;
     }
+    return result;
+}
 
-#else
+//
+// Comparison:
+//
 
-    std::basic_string<CharT, Traits>
-    to_string() const
+// index of first characters of [a, a + n) and [b, b + n) that differ, or n:
+
+template< class Traits, typename CharT >
+inline nssv_constexpr14 std::size_t mismatch( CharT const * a, CharT const * b, std::size_t n, false_type /*simd*/ )
+{
+    std::size_t i = 0;
+
+    while ( i != n && Traits::eq( a[i], b[i] ) )
     {
-        return std::basic_string<CharT, Traits>( begin(), end() );
+        ++i;
     }
+    return i;
+}
 
-    template< class Allocator >
-    std::basic_string<CharT, Traits, Allocator>
-    to_string( Allocator const & a ) const
+// index past last characters of [a, a + n) and [b, b + n) that differ, or 0:
+
+template< class Traits, typename CharT >
+inline nssv_constexpr14 std::size_t rmismatch( CharT const * a, CharT const * b, std::size_t n, false_type /*simd*/ )
+{
+    std::size_t i = n;
+
+    while ( i != 0 && Traits::eq( a[i - 1], b[i - 1] ) )
     {
-        return std::basic_string<CharT, Traits, Allocator>( begin(), end(), a );
+        --i;
     }
+    return i;
+}
 
-#endif // nssv_CPP11_OR_GREATER
+#if nssv_HAVE_SSE2
 
-#endif // nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
-};
+// compare 32 or 16 bytes at a time; the last block overlaps its predecessor:
 
-//
-// Non-member functions:
-//
+template< typename CharT >
+inline unsigned differ( CharT const * a, CharT const * b )
+{
+    return ~movemask( sse2_lanes< sizeof(CharT) >::eq( load128( a ), load128( b ) ) ) & 0xffffu;
+}
 
-// 24.4.3 Non-member comparison functions:
-// lexicographically compare two string views (function template):
+template< class Traits, typename CharT >
+std::size_t mismatch( CharT const * a, CharT const * b, std::size_t n, true_type /*simd*/ )
+{
+    const std::size_t lane = sizeof(CharT);
+    const std::size_t step = 16 / lane;
+    std::size_t i = 0;
 
-template< class CharT, class Traits >
-nssv_constexpr bool operator== (
-    basic_string_view <CharT, Traits> lhs,
-    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.size() == rhs.size() && lhs.compare( rhs ) == 0; }
+    if ( n < step )
+    {
+        return mismatch<Traits>( a, b, n, false_type() );
+    }
 
-template< class CharT, class Traits >
-nssv_constexpr bool operator!= (
-    basic_string_view <CharT, Traits> lhs,
-    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+#if nssv_HAVE_AVX2
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-template< class CharT, class Traits >
-nssv_constexpr bool operator< (
-    basic_string_view <CharT, Traits> lhs,
-    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) < 0; }
+    for ( ; i + 2 * step <= n; i += 2 * step )
+    {
+        const unsigned k = ~movemask( lanes::eq( load256( a + i ), load256( b + i ) ) );
 
-template< class CharT, class Traits >
-nssv_constexpr bool operator<= (
-    basic_string_view <CharT, Traits> lhs,
-    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) <= 0; }
+        if ( k != 0 )
+        {
+            return i + ctz( k ) / lane;
+        }
+    }
+#endif
+    for ( ; i + step <= n; i += step )
+    {
+        const unsigned k = differ( a + i, b + i );
 
-template< class CharT, class Traits >
-nssv_constexpr bool operator> (
-    basic_string_view <CharT, Traits> lhs,
-    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) > 0; }
+        if ( k != 0 )
+        {
+            return i + ctz( k ) / lane;
+        }
+    }
 
-template< class CharT, class Traits >
-nssv_constexpr bool operator>= (
-    basic_string_view <CharT, Traits> lhs,
-    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) >= 0; }
+    if ( i != n )
+    {
+        const unsigned k = differ( a + n - step, b + n - step );
 
-// Let S be basic_string_view<CharT, Traits>, and sv be an instance of S.
-// Implementations shall provide sufficient additional overloads marked
-// constexpr and noexcept so that an object t with an implicit conversion
-// to S can be compared according to Table 67.
+        if ( k != 0 )
+        {
+            return n - step + ctz( k ) / lane;
+        }
+    }
+    return n;
+}
 
-#if ! nssv_CPP11_OR_GREATER || nssv_BETWEEN( nssv_COMPILER_MSVC_VERSION, 100, 141 )
+// as mismatch(), from the back; the first block overlaps its successor:
 
-// accommodate for older compilers:
+template< class Traits, typename CharT >
+std::size_t rmismatch( CharT const * a, CharT const * b, std::size_t n, true_type /*simd*/ )
+{
+    const std::size_t lane = sizeof(CharT);
+    const std::size_t step = 16 / lane;
+    std::size_t i = n;
 
-// ==
+    if ( n < step )
+    {
+        return rmismatch<Traits>( a, b, n, false_type() );
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator==(
-    basic_string_view<CharT, Traits> lhs,
-    CharT const * rhs ) nssv_noexcept
-{ return lhs.size() == detail::length( rhs ) && lhs.compare( rhs ) == 0; }
+#if nssv_HAVE_AVX2
+    typedef sse2_lanes< sizeof(CharT) > lanes;
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator==(
-    CharT const * lhs,
-    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
-{ return detail::length( lhs ) == rhs.size() && rhs.compare( lhs ) == 0; }
+    for ( ; i >= 2 * step; i -= 2 * step )
+    {
+        const unsigned k = ~movemask( lanes::eq( load256( a + i - 2 * step ), load256( b + i - 2 * step ) ) );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator==(
-    basic_string_view<CharT, Traits> lhs,
-    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.size() == rhs.size() && lhs.compare( rhs ) == 0; }
+        if ( k != 0 )
+        {
+            return i - 2 * step + bsr( k ) / lane + 1;
+        }
+    }
+#endif
+    for ( ; i >= step; i -= step )
+    {
+        const unsigned k = differ( a + i - step, b + i - step );
+
+        if ( k != 0 )
+        {
+            return i - step + bsr( k ) / lane + 1;
+        }
+    }
+
+    if ( i != 0 )
+    {
+        const unsigned k = differ( a, b );
+
+        if ( k != 0 )
+        {
+            return bsr( k ) / lane + 1;
+        }
+    }
+    return 0;
+}
+
+#endif // nssv_HAVE_SSE2
+
+template< class Traits, typename CharT >
+inline std::size_t mismatch( CharT const * a, CharT const * b, std::size_t n )
+{
+    return mismatch<Traits>( a, b, n, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+template< class Traits, typename CharT >
+inline std::size_t rmismatch( CharT const * a, CharT const * b, std::size_t n )
+{
+    return rmismatch<Traits>( a, b, n, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// compare [a, a + n) and [b, b + n) as Traits::compare(): via memcmp() for
+// char, via mismatch() for the wider standard character types, and via
+// Traits::compare() for other traits, to honour their lt():
+
+template< class Traits, typename CharT >
+inline int compare_n( CharT const * a, CharT const * b, std::size_t n, false_type /*mismatch*/ )
+{
+    return Traits::compare( a, b, n );
+}
+
+template< class Traits, typename CharT >
+inline int compare_n( CharT const * a, CharT const * b, std::size_t n, true_type /*mismatch*/ )
+{
+    const std::size_t i = mismatch<Traits>( a, b, n );
+
+    return i == n ? 0 : Traits::lt( a[i], b[i] ) ? -1 : 1;
+}
+
+template< class Traits, typename CharT >
+inline int compare_n( CharT const * a, CharT const * b, std::size_t n )
+{
+    return compare_n<Traits>( a, b, n, bool_constant< use_simd<CharT, Traits>::value && sizeof(CharT) != 1 >() );
+}
+
+// compare as Traits::compare() in constant evaluation before C++17, where
+// Traits::compare() is not constexpr: via Traits::eq() and Traits::lt(),
+// or via compare() above for std::char_traits:
+
+template< class Traits, typename CharT >
+inline nssv_constexpr14 int compare_c( CharT const * a, CharT const * b, std::size_t n, true_type /*std char*/ )
+{
+    return compare( a, b, n );
+}
+
+template< class Traits, typename CharT >
+inline nssv_constexpr14 int compare_c( CharT const * a, CharT const * b, std::size_t n, false_type /*std char*/ )
+{
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        if ( ! Traits::eq( a[i], b[i] ) )
+        {
+            return Traits::lt( a[i], b[i] ) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+template< class Traits, typename CharT >
+inline nssv_constexpr14 int compare_c( CharT const * a, CharT const * b, std::size_t n )
+{
+    return compare_c<Traits>( a, b, n, is_std_char_traits<CharT, Traits>() );
+}
+
+//
+// ASCII case-insensitive comparison and search:
+//
+
+// character with ASCII 'A'-'Z' mapped to 'a'-'z':
+
+template< typename CharT >
+inline nssv_constexpr CharT fold_case( CharT c )
+{
+    return CharT( 'A' ) <= c && c <= CharT( 'Z' ) ? static_cast<CharT>( c - 'A' + 'a' ) : c;
+}
+
+// Traits comparing characters after fold_case(), for Two-Way:
+
+template< class Traits >
+struct fold_traits
+{
+    typedef typename Traits::char_type char_type;
+
+    static nssv_constexpr bool eq( char_type a, char_type b )
+    {
+        return Traits::eq( fold_case( a ), fold_case( b ) );
+    }
+
+    static nssv_constexpr bool lt( char_type a, char_type b )
+    {
+        return Traits::lt( fold_case( a ), fold_case( b ) );
+    }
+};
+
+// index of first characters of [a, a + n) and [b, b + n) that differ
+// after fold_case(), or n:
+
+template< class Traits, typename CharT >
+nssv_constexpr14 std::size_t fold_mismatch( CharT const * a, CharT const * b, std::size_t n )
+{
+    std::size_t i = 0;
+
+    while ( i != n && fold_traits<Traits>::eq( a[i], b[i] ) )
+    {
+        ++i;
+    }
+    return i;
+}
+
+#if nssv_HAVE_SSE2
+
+template< typename CharT >
+std::size_t fold_mismatch_simd( CharT const * a, CharT const * b, std::size_t n )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
+
+    const std::size_t lane = sizeof(CharT);
+    std::size_t i = 0;
+
+#if nssv_HAVE_AVX2
+    for ( const std::size_t step = 32 / lane; i + step <= n; i += step )
+    {
+        const unsigned k = ~movemask( lanes::eq( lanes::fold( load256( a + i ) ), lanes::fold( load256( b + i ) ) ) );
+
+        if ( k != 0 )
+        {
+            return i + ctz( k ) / lane;
+        }
+    }
+#endif
+    for ( const std::size_t step = 16 / lane; i + step <= n; i += step )
+    {
+        const unsigned k = ~movemask( lanes::eq( lanes::fold( load128( a + i ) ), lanes::fold( load128( b + i ) ) ) ) & 0xffffu;
+
+        if ( k != 0 )
+        {
+            return i + ctz( k ) / lane;
+        }
+    }
+    return i + fold_mismatch< std::char_traits<CharT> >( a + i, b + i, n - i );
+}
+
+// as search_simd(), filtering on the needle's folded first and last
+// character; 0 < m <= n:
+
+template< class Traits, typename CharT >
+std::size_t fold_search_simd( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    typedef sse2_lanes< sizeof(CharT) > lanes;
+
+    const std::size_t lane  = sizeof(CharT);
+    const unsigned    group = ( 1u << lane ) - 1u;
+
+#if nssv_HAVE_AVX2
+    const std::size_t step = 32 / lane;
+    const __m256i first = lanes::splat256( fold_case( p[0] ) );
+    const __m256i last  = lanes::splat256( fold_case( p[m - 1] ) );
+#else
+    const std::size_t step = 16 / lane;
+    const __m128i first = lanes::splat( fold_case( p[0] ) );
+    const __m128i last  = lanes::splat( fold_case( p[m - 1] ) );
+#endif
+
+    std::size_t i = 0;
+    std::size_t work = 0;
+
+    for ( ; i + step + m - 1 <= n; i += step )
+    {
+#if nssv_HAVE_AVX2
+        unsigned k = movemask( _mm256_and_si256(
+            lanes::eq( first, lanes::fold( load256( s + i         ) ) ),
+            lanes::eq( last , lanes::fold( load256( s + i + m - 1 ) ) ) ) );
+#else
+        unsigned k = movemask( _mm_and_si128(
+            lanes::eq( first, lanes::fold( load128( s + i         ) ) ),
+            lanes::eq( last , lanes::fold( load128( s + i + m - 1 ) ) ) ) );
+#endif
+        while ( k != 0 )
+        {
+            const unsigned bit = ctz( k );
+            const std::size_t idx = i + bit / lane;
+
+            work += m;
+
+            if ( fold_mismatch_simd( s + idx, p, m ) == m )
+            {
+                return idx;
+            }
+            k &= ~( group << bit );
+        }
+
+        if ( work > 8 * i + 1024 )
+        {
+            return add_pos( i, two_way_search< fold_traits<Traits> >( s + i, n - i, p, m ) );
+        }
+    }
+
+    // fewer than step candidate positions remain:
+
+    for ( ; i + m <= n; ++i )
+    {
+        if ( fold_mismatch_simd( s + i, p, m ) == m )
+        {
+            return i;
+        }
+    }
+    return npos;
+}
+
+#endif // nssv_HAVE_SSE2
+
+template< class Traits, typename CharT >
+inline std::size_t fold_mismatch( CharT const * a, CharT const * b, std::size_t n, false_type /*simd*/ )
+{
+    return fold_mismatch<Traits>( a, b, n );
+}
+
+template< class Traits, typename CharT >
+inline std::size_t fold_search( CharT const * s, std::size_t n, CharT const * p, std::size_t m, false_type /*simd*/ )
+{
+    return two_way_search< fold_traits<Traits> >( s, n, p, m );
+}
+
+#if nssv_HAVE_SSE2
+template< class Traits, typename CharT >
+inline std::size_t fold_mismatch( CharT const * a, CharT const * b, std::size_t n, true_type /*simd*/ )
+{
+    return fold_mismatch_simd( a, b, n );
+}
+
+template< class Traits, typename CharT >
+inline std::size_t fold_search( CharT const * s, std::size_t n, CharT const * p, std::size_t m, true_type /*simd*/ )
+{
+    return fold_search_simd<Traits>( s, n, p, m );
+}
+#endif
+
+// as fold_mismatch(), comparing 16 or 32 bytes at a time:
+
+template< class Traits, typename CharT >
+inline std::size_t fold_mismatch_fast( CharT const * a, CharT const * b, std::size_t n )
+{
+    return fold_mismatch<Traits>( a, b, n, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+// index of first occurrence of needle [p, p + m) in [s, s + n) after
+// fold_case(), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t fold_search( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? 0
+        :  m >  n ? npos
+        :  fold_search<Traits>( s, n, p, m, bool_constant< use_simd<CharT, Traits>::value >() );
+}
+
+//
+// Character set membership for find_first_of(), find_last_of() and their not_of variants:
+//
+
+// character value as unsigned number:
+
+template< typename CharT >
+inline nssv_constexpr unsigned long char_value( CharT c )
+{
+    return sizeof(CharT) == 1
+        ? static_cast<unsigned long>( static_cast<unsigned char>( c ) )
+        : static_cast<unsigned long>( c );
+}
+
+// set of characters, built once per search or once for a basic_char_set:
+// characters below 256 are held exactly in a 256-bit bitmap, wider characters
+// pass a 256-bit filter on a hash of their value and are then confirmed in
+// the set itself. For single-byte characters, sets with at most 8 different
+// high nibbles also provide two 16-entry nibble tables for SIMD classification.
+// For traits other than std::char_traits, characters are looked up in the set.
+
+template< typename CharT, class Traits >
+class char_table
+{
+public:
+    nssv_constexpr14 char_table( CharT const * set, std::size_t m )
+        : set_( set ), m_( m ), bits_(), wide_(), lo_(), hi_(), has_wide_( false ), has_nibbles_( false )
+    {
+        for ( std::size_t i = 0; i != m; ++i )
+        {
+            insert( set[i], is_std_char_traits<CharT, Traits>() );
+        }
+
+        if ( sizeof(CharT) == 1 && is_std_char_traits<CharT, Traits>::value )
+        {
+            make_nibble_tables();
+        }
+    }
+
+    nssv_constexpr14 bool contains( CharT c ) const
+    {
+        return contains( c, is_std_char_traits<CharT, Traits>() );
+    }
+
+    nssv_constexpr CharT const * data() const { return set_; }
+    nssv_constexpr std::size_t   size() const { return m_; }
+
+    nssv_constexpr bool has_nibbles() const { return has_nibbles_; }
+
+    nssv_constexpr unsigned char const * lo_nibbles() const { return lo_; }
+    nssv_constexpr unsigned char const * hi_nibbles() const { return hi_; }
+
+private:
+    nssv_constexpr14 void insert( CharT c, true_type /*std*/ )
+    {
+        const unsigned long v = char_value( c );
+
+        if ( v < 256 )
+        {
+            set_bit( bits_, v );
+        }
+        else
+        {
+            set_bit( wide_, hash( v ) );
+            has_wide_ = true;
+        }
+    }
+
+    nssv_constexpr14 void insert( CharT, false_type /*std*/ ) {}
+
+    nssv_constexpr14 bool contains( CharT c, true_type /*std*/ ) const
+    {
+        const unsigned long v = char_value( c );
+
+        return v < 256
+            ? test_bit( bits_, v )
+            : has_wide_ && test_bit( wide_, hash( v ) ) && Traits::find( set_, m_, c ) != nssv_nullptr;
+    }
+
+    nssv_constexpr14 bool contains( CharT c, false_type /*std*/ ) const
+    {
+        return Traits::find( set_, m_, c ) != nssv_nullptr;
+    }
+
+    static nssv_constexpr unsigned long hash( unsigned long v )
+    {
+        return ( v ^ ( v >> 8 ) ^ ( v >> 16 ) ) & 0xffu;
+    }
+
+    static nssv_constexpr14 void set_bit( unsigned char * bits, unsigned long v )
+    {
+        bits[ v >> 3 ] = static_cast<unsigned char>( bits[ v >> 3 ] | ( 1u << ( v & 7u ) ) );
+    }
+
+    static nssv_constexpr bool test_bit( unsigned char const * bits, unsigned long v )
+    {
+        return ( bits[ v >> 3 ] & ( 1u << ( v & 7u ) ) ) != 0;
+    }
+
+    // byte b is in the set if lo_[b & 0xf] & hi_[b >> 4] is non-zero;
+    // high nibbles with the same set of low nibbles share a bucket bit:
+
+    nssv_constexpr14 void make_nibble_tables()
+    {
+        unsigned short row[16] = { 0 };
+        unsigned short bucket_row[8] = { 0 };
+        unsigned buckets = 0;
+
+        for ( unsigned hi = 0; hi != 16; ++hi )
+        {
+            row[hi] = static_cast<unsigned short>( bits_[2 * hi] | ( bits_[2 * hi + 1] << 8 ) );
+        }
+
+        for ( unsigned hi = 0; hi != 16; ++hi )
+        {
+            if ( row[hi] == 0 )
+                continue;
+
+            unsigned b = 0;
+            while ( b != buckets && bucket_row[b] != row[hi] )
+                ++b;
+
+            if ( b == buckets )
+            {
+                if ( buckets == 8 )
+                    return;
+                bucket_row[ buckets++ ] = row[hi];
+            }
+
+            hi_[hi] = static_cast<unsigned char>( 1u << b );
+
+            for ( unsigned lo = 0; lo != 16; ++lo )
+            {
+                if ( row[hi] & ( 1u << lo ) )
+                {
+                    lo_[lo] = static_cast<unsigned char>( lo_[lo] | ( 1u << b ) );
+                }
+            }
+        }
+        has_nibbles_ = true;
+    }
+
+    CharT const * set_;
+    std::size_t m_;
+    unsigned char bits_[32];
+    unsigned char wide_[32];
+    unsigned char lo_[16];
+    unsigned char hi_[16];
+    bool has_wide_;
+    bool has_nibbles_;
+};
+
+// single-byte characters that can be classified via nibble tables:
+
+template< class CharT, class Traits >
+struct use_nibbles : bool_constant<
+    ( nssv_HAVE_SSSE3 != 0 )
+    && is_std_char_traits<CharT, Traits>::value
+    && sizeof(CharT) == 1 > {};
+
+#if nssv_HAVE_SSSE3
+
+// per byte of x, the bucket bits of the nibble tables lo, hi:
+
+inline __m128i classify( __m128i x, __m128i lo, __m128i hi )
+{
+    const __m128i nibble = _mm_set1_epi8( 0x0f );
+
+    return _mm_and_si128(
+        _mm_shuffle_epi8( lo, _mm_and_si128( x, nibble ) ),
+        _mm_shuffle_epi8( hi, _mm_and_si128( _mm_srli_epi16( x, 4 ), nibble ) ) );
+}
+
+// bit per byte of x, set if the byte is in the set of the nibble tables lo, hi:
+
+inline unsigned in_set( __m128i x, __m128i lo, __m128i hi )
+{
+    return ~movemask( _mm_cmpeq_epi8( classify( x, lo, hi ), _mm_setzero_si128() ) ) & 0xffffu;
+}
+
+#if nssv_HAVE_AVX2
+
+inline __m256i classify( __m256i x, __m256i lo, __m256i hi )
+{
+    const __m256i nibble = _mm256_set1_epi8( 0x0f );
+
+    return _mm256_and_si256(
+        _mm256_shuffle_epi8( lo, _mm256_and_si256( x, nibble ) ),
+        _mm256_shuffle_epi8( hi, _mm256_and_si256( _mm256_srli_epi16( x, 4 ), nibble ) ) );
+}
+
+inline unsigned in_set( __m256i x, __m256i lo, __m256i hi )
+{
+    return ~movemask( _mm256_cmpeq_epi8( classify( x, lo, hi ), _mm256_setzero_si256() ) );
+}
+
+#endif // nssv_HAVE_AVX2
+
+// bits of k that are set for the characters to find, in or not in the set:
+
+inline unsigned select_bits( unsigned k, bool member, unsigned all )
+{
+    return member ? k : ~k & all;
+}
+
+// index of first character of [s, s + n) that is in (member), or not in
+// the set of table t:
+
+template< typename CharT, class Traits >
+std::size_t find_of_simd( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member )
+{
+    const __m128i lo = load128( t.lo_nibbles() );
+    const __m128i hi = load128( t.hi_nibbles() );
+    std::size_t i = 0;
+
+#if nssv_HAVE_AVX2
+    const __m256i lo2 = _mm256_broadcastsi128_si256( lo );
+    const __m256i hi2 = _mm256_broadcastsi128_si256( hi );
+
+    for ( ; i + 32 <= n; i += 32 )
+    {
+        const unsigned k = select_bits( in_set( load256( s + i ), lo2, hi2 ), member, 0xffffffffu );
+
+        if ( k != 0 )
+        {
+            return i + ctz( k );
+        }
+    }
+#endif
+    for ( ; i + 16 <= n; i += 16 )
+    {
+        const unsigned k = select_bits( in_set( load128( s + i ), lo, hi ), member, 0xffffu );
+
+        if ( k != 0 )
+        {
+            return i + ctz( k );
+        }
+    }
+
+    for ( ; i < n; ++i )
+    {
+        if ( t.contains( s[i] ) == member )
+        {
+            return i;
+        }
+    }
+    return npos;
+}
+
+// index of last character of [s, s + n) that is in (member), or not in
+// the set of table t:
+
+template< typename CharT, class Traits >
+std::size_t rfind_of_simd( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member )
+{
+    const __m128i lo = load128( t.lo_nibbles() );
+    const __m128i hi = load128( t.hi_nibbles() );
+    std::size_t i = n;
+
+#if nssv_HAVE_AVX2
+    const __m256i lo2 = _mm256_broadcastsi128_si256( lo );
+    const __m256i hi2 = _mm256_broadcastsi128_si256( hi );
+
+    for ( ; i >= 32; i -= 32 )
+    {
+        const unsigned k = select_bits( in_set( load256( s + i - 32 ), lo2, hi2 ), member, 0xffffffffu );
+
+        if ( k != 0 )
+        {
+            return i - 32 + bsr( k );
+        }
+    }
+#endif
+    for ( ; i >= 16; i -= 16 )
+    {
+        const unsigned k = select_bits( in_set( load128( s + i - 16 ), lo, hi ), member, 0xffffu );
+
+        if ( k != 0 )
+        {
+            return i - 16 + bsr( k );
+        }
+    }
+
+    while ( i-- != 0 )
+    {
+        if ( t.contains( s[i] ) == member )
+        {
+            return i;
+        }
+    }
+    return npos;
+}
+
+#endif // nssv_HAVE_SSSE3
+
+// scan with table t, using the nibble tables when present:
+
+template< typename CharT, class Traits >
+std::size_t find_in_table( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member, false_type /*nibbles*/ )
+{
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        if ( t.contains( s[i] ) == member )
+        {
+            return i;
+        }
+    }
+    return npos;
+}
+
+template< typename CharT, class Traits >
+std::size_t rfind_in_table( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member, false_type /*nibbles*/ )
+{
+    while ( n-- != 0 )
+    {
+        if ( t.contains( s[n] ) == member )
+        {
+            return n;
+        }
+    }
+    return npos;
+}
+
+#if nssv_HAVE_SSSE3
+template< typename CharT, class Traits >
+inline std::size_t find_in_table( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member, true_type /*nibbles*/ )
+{
+    return t.has_nibbles() ? find_of_simd( s, n, t, member ) : find_in_table( s, n, t, member, false_type() );
+}
+
+template< typename CharT, class Traits >
+inline std::size_t rfind_in_table( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member, true_type /*nibbles*/ )
+{
+    return t.has_nibbles() ? rfind_of_simd( s, n, t, member ) : rfind_in_table( s, n, t, member, false_type() );
+}
+#endif
+
+// index of first (last) character of [s, s + n) in (member) or not in table t:
+
+template< typename CharT, class Traits >
+inline std::size_t find_in_table( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member )
+{
+    return find_in_table( s, n, t, member, bool_constant< use_nibbles<CharT, Traits>::value >() );
+}
+
+template< typename CharT, class Traits >
+inline std::size_t rfind_in_table( CharT const * s, std::size_t n, char_table<CharT, Traits> const & t, bool member )
+{
+    return rfind_in_table( s, n, t, member, bool_constant< use_nibbles<CharT, Traits>::value >() );
+}
+
+// with a table for the standard character types; for other traits,
+// characters can only be compared via Traits::eq():
+
+template< class Traits, typename CharT >
+std::size_t find_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m, bool member, false_type /*table*/ )
+{
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        if ( ( Traits::find( p, m, s[i] ) != nssv_nullptr ) == member )
+        {
+            return i;
+        }
+    }
+    return npos;
+}
+
+template< class Traits, typename CharT >
+std::size_t rfind_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m, bool member, false_type /*table*/ )
+{
+    while ( n-- != 0 )
+    {
+        if ( ( Traits::find( p, m, s[n] ) != nssv_nullptr ) == member )
+        {
+            return n;
+        }
+    }
+    return npos;
+}
+
+template< class Traits, typename CharT >
+inline std::size_t find_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m, bool member, true_type /*table*/ )
+{
+    return find_in_table( s, n, char_table<CharT, Traits>( p, m ), member );
+}
+
+template< class Traits, typename CharT >
+inline std::size_t rfind_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m, bool member, true_type /*table*/ )
+{
+    return rfind_in_table( s, n, char_table<CharT, Traits>( p, m ), member );
+}
+
+// index of first character of [s, s + n) that occurs in [p, p + m), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t find_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? npos
+        :  m == 1 ? find_char<Traits>( s, n, p[0] )
+        :  find_of<Traits>( s, n, p, m, true, bool_constant< is_std_char_traits<CharT, Traits>::value >() );
+}
+
+// index of last character of [s, s + n) that occurs in [p, p + m), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t rfind_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? npos
+        :  m == 1 ? rfind_char<Traits>( s, n, p[0] )
+        :  rfind_of<Traits>( s, n, p, m, true, bool_constant< is_std_char_traits<CharT, Traits>::value >() );
+}
+
+// index of first character of [s, s + n) that does not occur in [p, p + m), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t find_not_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? ( n == 0 ? npos : 0 )
+        :  find_of<Traits>( s, n, p, m, false, bool_constant< is_std_char_traits<CharT, Traits>::value >() );
+}
+
+// index of last character of [s, s + n) that does not occur in [p, p + m), or npos:
+
+template< class Traits, typename CharT >
+inline std::size_t rfind_not_of( CharT const * s, std::size_t n, CharT const * p, std::size_t m )
+{
+    return m == 0 ? ( n == 0 ? npos : n - 1 )
+        :  rfind_of<Traits>( s, n, p, m, false, bool_constant< is_std_char_traits<CharT, Traits>::value >() );
+}
+
+} // namespace detail
+
+//
+// basic_string_view:
+//
+
+template
+<
+    class CharT,
+    class Traits /* = std::char_traits<CharT> */
+>
+class basic_string_view
+{
+public:
+    // Member types:
+
+    typedef Traits traits_type;
+    typedef CharT  value_type;
+
+    typedef CharT       * pointer;
+    typedef CharT const * const_pointer;
+    typedef CharT       & reference;
+    typedef CharT const & const_reference;
+
+    typedef const_pointer iterator;
+    typedef const_pointer const_iterator;
+    typedef std::reverse_iterator< const_iterator > reverse_iterator;
+    typedef std::reverse_iterator< const_iterator > const_reverse_iterator;
+
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+
+    // 24.4.2.1 Construction and assignment:
+
+    nssv_constexpr basic_string_view() nssv_noexcept
+        : data_( nssv_nullptr )
+        , size_( 0 )
+    {}
+
+#if nssv_CPP11_OR_GREATER
+    nssv_constexpr basic_string_view( basic_string_view const & other ) nssv_noexcept = default;
+#else
+    nssv_constexpr basic_string_view( basic_string_view const & other ) nssv_noexcept
+        : data_( other.data_)
+        , size_( other.size_)
+    {}
+#endif
+
+    nssv_constexpr basic_string_view( CharT const * s, size_type count ) nssv_noexcept // non-standard noexcept
+        : data_( s )
+        , size_( count )
+    {}
+
+    nssv_constexpr basic_string_view( CharT const * s) nssv_noexcept // non-standard noexcept
+        : data_( s )
+#if nssv_CPP17_OR_GREATER
+        , size_( nssv_is_constant_evaluated() || ! detail::is_std_char_traits<CharT, Traits>::value ? Traits::length(s) : detail::length_runtime(s) )
+#elif nssv_CPP11_OR_GREATER
+        , size_( detail::length(s) )
+#else
+        , size_( Traits::length(s) )
+#endif
+    {}
+
+#if  nssv_HAVE_NULLPTR
+# if nssv_HAVE_IS_DELETE
+    nssv_constexpr basic_string_view( std::nullptr_t ) nssv_noexcept = delete;
+# else
+    private: nssv_constexpr basic_string_view( std::nullptr_t ) nssv_noexcept; public:
+# endif
+#endif
+
+    // Assignment:
+
+#if nssv_CPP11_OR_GREATER
+    nssv_constexpr14 basic_string_view & operator=( basic_string_view const & other ) nssv_noexcept = default;
+#else
+    nssv_constexpr14 basic_string_view & operator=( basic_string_view const & other ) nssv_noexcept
+    {
+        data_ = other.data_;
+        size_ = other.size_;
+        return *this;
+    }
+#endif
+
+    // 24.4.2.2 Iterator support:
+
+    nssv_constexpr const_iterator begin()  const nssv_noexcept { return data_;         }
+    nssv_constexpr const_iterator end()    const nssv_noexcept { return data_ + size_; }
+
+    nssv_constexpr const_iterator cbegin() const nssv_noexcept { return begin(); }
+    nssv_constexpr const_iterator cend()   const nssv_noexcept { return end();   }
+
+    nssv_constexpr const_reverse_iterator rbegin()  const nssv_noexcept { return const_reverse_iterator( end() );   }
+    nssv_constexpr const_reverse_iterator rend()    const nssv_noexcept { return const_reverse_iterator( begin() ); }
+
+    nssv_constexpr const_reverse_iterator crbegin() const nssv_noexcept { return rbegin(); }
+    nssv_constexpr const_reverse_iterator crend()   const nssv_noexcept { return rend();   }
+
+    // 24.4.2.3 Capacity:
+
+    nssv_constexpr size_type size()     const nssv_noexcept { return size_; }
+    nssv_constexpr size_type length()   const nssv_noexcept { return size_; }
+    nssv_constexpr size_type max_size() const nssv_noexcept { return (std::numeric_limits< size_type >::max)(); }
+
+    // since C++20
+    nssv_nodiscard nssv_constexpr bool empty() const nssv_noexcept
+    {
+        return 0 == size_;
+    }
+
+    // 24.4.2.4 Element access:
+
+    nssv_constexpr const_reference operator[]( size_type pos ) const
+    {
+        return data_at( pos );
+    }
+
+    nssv_constexpr14 const_reference at( size_type pos ) const
+    {
+#if nssv_CONFIG_NO_EXCEPTIONS
+        assert( pos < size() );
+#else
+        if ( pos >= size() )
+        {
+            throw std::out_of_range("nonstd::string_view::at()");
+        }
+#endif
+        return data_at( pos );
+    }
+
+    nssv_constexpr const_reference front() const { return data_at( 0 );          }
+    nssv_constexpr const_reference back()  const { return data_at( size() - 1 ); }
+
+    nssv_constexpr const_pointer   data()  const nssv_noexcept { return data_; }
+
+    // 24.4.2.5 Modifiers:
+
+    nssv_constexpr14 void remove_prefix( size_type n )
+    {
+        assert( n <= size() );
+        data_ += n;
+        size_ -= n;
+    }
+
+    nssv_constexpr14 void remove_suffix( size_type n )
+    {
+        assert( n <= size() );
+        size_ -= n;
+    }
+
+    nssv_constexpr14 void swap( basic_string_view & other ) nssv_noexcept
+    {
+        const basic_string_view tmp(other);
+        other = *this;
+        *this = tmp;
+    }
+
+    // 24.4.2.6 String operations:
+
+    size_type copy( CharT * dest, size_type n, size_type pos = 0 ) const
+    {
+#if nssv_CONFIG_NO_EXCEPTIONS
+        assert( pos <= size() );
+#else
+        if ( pos > size() )
+        {
+            throw std::out_of_range("nonstd::string_view::copy()");
+        }
+#endif
+        const size_type rlen = (std::min)( n, size() - pos );
+
+        (void) Traits::copy( dest, data() + pos, rlen );
+
+        return rlen;
+    }
+
+    nssv_constexpr14 basic_string_view substr( size_type pos = 0, size_type n = npos ) const
+    {
+#if nssv_CONFIG_NO_EXCEPTIONS
+        assert( pos <= size() );
+#else
+        if ( pos > size() )
+        {
+            throw std::out_of_range("nonstd::string_view::substr()");
+        }
+#endif
+        return basic_string_view( data() + pos, (std::min)( n, size() - pos ) );
+    }
+
+    // compare(), 6x:
+
+    nssv_constexpr14 int compare( basic_string_view other ) const nssv_noexcept // (1)
+    {
+        if ( const int result = ! nssv_is_constant_evaluated14()
+            ? detail::compare_n<Traits>( data(), other.data(), (std::min)( size(), other.size() ) )
+#if nssv_CPP17_OR_GREATER
+            : Traits::compare( data(), other.data(), (std::min)( size(), other.size() ) ) )
+#else
+            : detail::compare_c<Traits>( data(), other.data(), (std::min)( size(), other.size() ) ) )
+#endif
+        {
+            return result;
+        }
+
+        return size() == other.size() ? 0 : size() < other.size() ? -1 : 1;
+    }
+
+    nssv_constexpr int compare( size_type pos1, size_type n1, basic_string_view other ) const // (2)
+    {
+        return substr( pos1, n1 ).compare( other );
+    }
+
+    nssv_constexpr int compare( size_type pos1, size_type n1, basic_string_view other, size_type pos2, size_type n2 ) const // (3)
+    {
+        return substr( pos1, n1 ).compare( other.substr( pos2, n2 ) );
+    }
+
+    nssv_constexpr int compare( CharT const * s ) const // (4)
+    {
+        return compare( basic_string_view( s ) );
+    }
+
+    nssv_constexpr int compare( size_type pos1, size_type n1, CharT const * s ) const // (5)
+    {
+        return substr( pos1, n1 ).compare( basic_string_view( s ) );
+    }
+
+    nssv_constexpr int compare( size_type pos1, size_type n1, CharT const * s, size_type n2 ) const // (6)
+    {
+        return substr( pos1, n1 ).compare( basic_string_view( s, n2 ) );
+    }
+
+    // 24.4.2.7 Searching:
+
+    // starts_with(), 3x, since C++20:
+
+    nssv_constexpr bool starts_with( basic_string_view v ) const nssv_noexcept  // (1)
+    {
+        return size() >= v.size() && compare( 0, v.size(), v ) == 0;
+    }
+
+    nssv_constexpr bool starts_with( CharT c ) const nssv_noexcept  // (2)
+    {
+        return starts_with( basic_string_view( &c, 1 ) );
+    }
+
+    nssv_constexpr bool starts_with( CharT const * s ) const  // (3)
+    {
+        return starts_with( basic_string_view( s ) );
+    }
+
+    // ends_with(), 3x, since C++20:
+
+    nssv_constexpr bool ends_with( basic_string_view v ) const nssv_noexcept  // (1)
+    {
+        return size() >= v.size() && compare( size() - v.size(), npos, v ) == 0;
+    }
+
+    nssv_constexpr bool ends_with( CharT c ) const nssv_noexcept  // (2)
+    {
+        return ends_with( basic_string_view( &c, 1 ) );
+    }
+
+    nssv_constexpr bool ends_with( CharT const * s ) const  // (3)
+    {
+        return ends_with( basic_string_view( s ) );
+    }
+
+    // find(), 4x:
+
+    nssv_constexpr size_type find( basic_string_view v, size_type pos = 0 ) const nssv_noexcept  // (1)
+    {
+        return assert( v.size() == 0 || v.data() != nssv_nullptr )
+            , pos >= size()
+            ? npos : ! nssv_is_constant_evaluated()
+            ? to_pos( pos, detail::find_string<Traits>( data() + pos, size() - pos, v.data(), v.size() ) )
+            : to_pos(
+#if nssv_CPP11_OR_GREATER && ! nssv_CPP20_OR_GREATER
+                detail::search( basic_string_view( data() + pos, size() - pos ), v )
+#else
+                std::search( cbegin() + pos, cend(), v.cbegin(), v.cend(), Traits::eq )
+#endif
+            );
+    }
+
+    nssv_constexpr size_type find( CharT c, size_type pos = 0 ) const nssv_noexcept  // (2)
+    {
+        return nssv_is_constant_evaluated()
+            ? find( basic_string_view( &c, 1 ), pos )
+            : pos >= size()
+            ? npos
+            : to_pos( pos, detail::find_char<Traits>( data() + pos, size() - pos, c ) );
+    }
+
+    nssv_constexpr size_type find( CharT const * s, size_type pos, size_type n ) const  // (3)
+    {
+        return find( basic_string_view( s, n ), pos );
+    }
+
+    nssv_constexpr size_type find( CharT const * s, size_type pos = 0 ) const  // (4)
+    {
+        return find( basic_string_view( s ), pos );
+    }
+
+    // rfind(), 4x:
+
+    nssv_constexpr14 size_type rfind( basic_string_view v, size_type pos = npos ) const nssv_noexcept  // (1)
+    {
+        if ( size() < v.size() )
+        {
+            return npos;
+        }
+
+        if ( v.empty() )
+        {
+            return (std::min)( size(), pos );
+        }
+
+        if ( ! nssv_is_constant_evaluated14() )
+        {
+            return detail::rfind_string<Traits>( data(), (std::min)( size() - v.size(), pos ) + v.size(), v.data(), v.size() );
+        }
+
+        const_iterator last   = cbegin() + (std::min)( size() - v.size(), pos ) + v.size();
+        const_iterator result = std::find_end( cbegin(), last, v.cbegin(), v.cend(), Traits::eq );
+
+        return result != last ? size_type( result - cbegin() ) : npos;
+    }
+
+    nssv_constexpr14 size_type rfind( CharT c, size_type pos = npos ) const nssv_noexcept  // (2)
+    {
+        return nssv_is_constant_evaluated14()
+            ? rfind( basic_string_view( &c, 1 ), pos )
+            : empty()
+            ? npos
+            : detail::rfind_char<Traits>( data(), (std::min)( size() - 1, pos ) + 1, c );
+    }
+
+    nssv_constexpr14 size_type rfind( CharT const * s, size_type pos, size_type n ) const  // (3)
+    {
+        return rfind( basic_string_view( s, n ), pos );
+    }
+
+    nssv_constexpr14 size_type rfind( CharT const * s, size_type pos = npos ) const  // (4)
+    {
+        return rfind( basic_string_view( s ), pos );
+    }
+
+    // find_first_of(), 4x:
+
+    nssv_constexpr size_type find_first_of( basic_string_view v, size_type pos = 0 ) const nssv_noexcept  // (1)
+    {
+        return pos >= size()
+            ? npos
+            : nssv_is_constant_evaluated()
+            ? to_pos( std::find_first_of( cbegin() + pos, cend(), v.cbegin(), v.cend(), Traits::eq ) )
+            : to_pos( pos, detail::find_of<Traits>( data() + pos, size() - pos, v.data(), v.size() ) );
+    }
+
+    nssv_constexpr size_type find_first_of( CharT c, size_type pos = 0 ) const nssv_noexcept  // (2)
+    {
+        return find_first_of( basic_string_view( &c, 1 ), pos );
+    }
+
+    nssv_constexpr size_type find_first_of( CharT const * s, size_type pos, size_type n ) const  // (3)
+    {
+        return find_first_of( basic_string_view( s, n ), pos );
+    }
+
+    nssv_constexpr size_type find_first_of(  CharT const * s, size_type pos = 0 ) const  // (4)
+    {
+        return find_first_of( basic_string_view( s ), pos );
+    }
+
+    // find_last_of(), 4x:
+
+    nssv_constexpr size_type find_last_of( basic_string_view v, size_type pos = npos ) const nssv_noexcept  // (1)
+    {
+        return empty()
+            ? npos
+            : pos >= size()
+            ? find_last_of( v, size() - 1 )
+            : nssv_is_constant_evaluated()
+            ? to_pos( std::find_first_of( const_reverse_iterator( cbegin() + pos + 1 ), crend(), v.cbegin(), v.cend(), Traits::eq ) )
+            : detail::rfind_of<Traits>( data(), pos + 1, v.data(), v.size() );
+    }
+
+    nssv_constexpr size_type find_last_of( CharT c, size_type pos = npos ) const nssv_noexcept  // (2)
+    {
+        return find_last_of( basic_string_view( &c, 1 ), pos );
+    }
+
+    nssv_constexpr size_type find_last_of( CharT const * s, size_type pos, size_type count ) const  // (3)
+    {
+        return find_last_of( basic_string_view( s, count ), pos );
+    }
+
+    nssv_constexpr size_type find_last_of( CharT const * s, size_type pos = npos ) const  // (4)
+    {
+        return find_last_of( basic_string_view( s ), pos );
+    }
+
+    // find_first_not_of(), 4x:
+
+    nssv_constexpr size_type find_first_not_of( basic_string_view v, size_type pos = 0 ) const nssv_noexcept  // (1)
+    {
+        return pos >= size()
+            ? npos
+            : nssv_is_constant_evaluated()
+            ? first_not_of( v, pos )
+            : to_pos( pos, detail::find_not_of<Traits>( data() + pos, size() - pos, v.data(), v.size() ) );
+    }
+
+    nssv_constexpr size_type find_first_not_of( CharT c, size_type pos = 0 ) const nssv_noexcept  // (2)
+    {
+        return find_first_not_of( basic_string_view( &c, 1 ), pos );
+    }
+
+    nssv_constexpr size_type find_first_not_of( CharT const * s, size_type pos, size_type count ) const  // (3)
+    {
+        return find_first_not_of( basic_string_view( s, count ), pos );
+    }
+
+    nssv_constexpr size_type find_first_not_of( CharT const * s, size_type pos = 0 ) const  // (4)
+    {
+        return find_first_not_of( basic_string_view( s ), pos );
+    }
+
+    // find_last_not_of(), 4x:
+
+    nssv_constexpr size_type find_last_not_of( basic_string_view v, size_type pos = npos ) const nssv_noexcept  // (1)
+    {
+        return empty()
+            ? npos
+            : pos >= size()
+            ? find_last_not_of( v, size() - 1 )
+            : nssv_is_constant_evaluated()
+            ? last_not_of( v, pos )
+            : detail::rfind_not_of<Traits>( data(), pos + 1, v.data(), v.size() );
+    }
+
+    nssv_constexpr size_type find_last_not_of( CharT c, size_type pos = npos ) const nssv_noexcept  // (2)
+    {
+        return find_last_not_of( basic_string_view( &c, 1 ), pos );
+    }
+
+    nssv_constexpr size_type find_last_not_of( CharT const * s, size_type pos, size_type count ) const  // (3)
+    {
+        return find_last_not_of( basic_string_view( s, count ), pos );
+    }
+
+    nssv_constexpr size_type find_last_not_of( CharT const * s, size_type pos = npos ) const  // (4)
+    {
+        return find_last_not_of( basic_string_view( s ), pos );
+    }
+
+    // find_first_of() and friends for a prepared set of characters (extension):
+
+    size_type find_first_of( basic_char_set<CharT, Traits> const & set, size_type pos = 0 ) const nssv_noexcept
+    {
+        return pos >= size()
+            ? npos
+            : to_pos( pos, detail::find_in_table( data() + pos, size() - pos, set.table_, true ) );
+    }
+
+    size_type find_last_of( basic_char_set<CharT, Traits> const & set, size_type pos = npos ) const nssv_noexcept
+    {
+        return empty()
+            ? npos
+            : detail::rfind_in_table( data(), (std::min)( size() - 1, pos ) + 1, set.table_, true );
+    }
+
+    size_type find_first_not_of( basic_char_set<CharT, Traits> const & set, size_type pos = 0 ) const nssv_noexcept
+    {
+        return pos >= size()
+            ? npos
+            : to_pos( pos, detail::find_in_table( data() + pos, size() - pos, set.table_, false ) );
+    }
+
+    size_type find_last_not_of( basic_char_set<CharT, Traits> const & set, size_type pos = npos ) const nssv_noexcept
+    {
+        return empty()
+            ? npos
+            : detail::rfind_in_table( data(), (std::min)( size() - 1, pos ) + 1, set.table_, false );
+    }
+
+    // ASCII case-insensitive comparison and search (extension):
+
+    nssv_constexpr14 int icompare( basic_string_view other ) const nssv_noexcept
+    {
+        const size_type n = (std::min)( size(), other.size() );
+        const size_type i = fold_mismatch( data(), other.data(), n );
+
+        return i != n ? ( detail::fold_traits<Traits>::lt( data_[i], other.data_[i] ) ? -1 : 1 )
+            : size() == other.size() ? 0 : size() < other.size() ? -1 : 1;
+    }
+
+    nssv_constexpr14 bool iequals( basic_string_view other ) const nssv_noexcept
+    {
+        return size() == other.size() && fold_mismatch( data(), other.data(), size() ) == size();
+    }
+
+    nssv_constexpr14 bool istarts_with( basic_string_view v ) const nssv_noexcept
+    {
+        return size() >= v.size() && fold_mismatch( data(), v.data(), v.size() ) == v.size();
+    }
+
+    nssv_constexpr14 bool iends_with( basic_string_view v ) const nssv_noexcept
+    {
+        return size() >= v.size() && fold_mismatch( data() + size() - v.size(), v.data(), v.size() ) == v.size();
+    }
+
+    nssv_constexpr14 size_type ifind( basic_string_view v, size_type pos = 0 ) const nssv_noexcept
+    {
+        return assert( v.size() == 0 || v.data() != nssv_nullptr )
+            , pos >= size()
+            ? npos : ! nssv_is_constant_evaluated14()
+            ? to_pos( pos, detail::fold_search<Traits>( data() + pos, size() - pos, v.data(), v.size() ) )
+            : ifind_naive( v, pos );
+    }
+
+    // count(), 2x (extension):
+
+    nssv_constexpr14 size_type count( CharT c ) const nssv_noexcept
+    {
+        return ! nssv_is_constant_evaluated14()
+            ? detail::count_char<Traits>( data(), size(), c )
+            : occurrences( c );
+    }
+
+    nssv_constexpr14 size_type count( basic_string_view v ) const nssv_noexcept
+    {
+        return assert( v.size() == 0 || v.data() != nssv_nullptr )
+            , ! nssv_is_constant_evaluated14()
+            ? detail::count_string<Traits>( data(), size(), v.data(), v.size() )
+            : occurrences( v );
+    }
+
+    // common prefix and suffix, first and last mismatch (extension):
+
+    nssv_constexpr14 size_type common_prefix_length( basic_string_view other ) const nssv_noexcept
+    {
+        return ! nssv_is_constant_evaluated14()
+            ? detail::mismatch<Traits>( data(), other.data(), (std::min)( size(), other.size() ) )
+            : detail::mismatch<Traits>( data(), other.data(), (std::min)( size(), other.size() ), detail::false_type() );
+    }
+
+    nssv_constexpr14 size_type common_suffix_length( basic_string_view other ) const nssv_noexcept
+    {
+        const size_type n = (std::min)( size(), other.size() );
+        const_pointer a = data() + ( size() - n );
+        const_pointer b = other.data() + ( other.size() - n );
+
+        return n - ( ! nssv_is_constant_evaluated14()
+            ? detail::rmismatch<Traits>( a, b, n )
+            : detail::rmismatch<Traits>( a, b, n, detail::false_type() ) );
+    }
+
+    nssv_constexpr14 size_type mismatch_pos( basic_string_view other ) const nssv_noexcept
+    {
+        const size_type i = common_prefix_length( other );
+        return i != size() ? i : npos;
+    }
+
+    nssv_constexpr14 size_type rmismatch_pos( basic_string_view other ) const nssv_noexcept
+    {
+        const size_type i = common_suffix_length( other );
+        return i != size() ? size() - 1 - i : npos;
+    }
+
+    // Constants:
+
+#if nssv_CPP17_OR_GREATER
+    static nssv_constexpr size_type npos = size_type(-1);
+#elif nssv_CPP11_OR_GREATER
+    enum : size_type { npos = size_type(-1) };
+#else
+    enum { npos = size_type(-1) };
+#endif
+
+private:
+    // ASCII case-insensitive mismatch, and constant evaluation of ifind():
+
+    static nssv_constexpr14 size_type fold_mismatch( const_pointer a, const_pointer b, size_type n ) nssv_noexcept
+    {
+        return ! nssv_is_constant_evaluated14()
+            ? detail::fold_mismatch_fast<Traits>( a, b, n )
+            : detail::fold_mismatch<Traits>( a, b, n );
+    }
+
+    nssv_constexpr14 size_type ifind_naive( basic_string_view v, size_type pos ) const nssv_noexcept
+    {
+        for ( ; v.size() <= size() - pos && pos != size(); ++pos )
+        {
+            if ( detail::fold_mismatch<Traits>( data_ + pos, v.data_, v.size() ) == v.size() )
+                return pos;
+        }
+        return npos;
+    }
+
+    // constant evaluation of count():
+
+    nssv_constexpr14 size_type occurrences( CharT c ) const nssv_noexcept
+    {
+        size_type result = 0;
+
+        for ( size_type i = 0; i != size(); ++i )
+        {
+            if ( Traits::eq( data_[i], c ) )
+                ++result;
+        }
+        return result;
+    }
+
+    nssv_constexpr14 size_type occurrences( basic_string_view v ) const nssv_noexcept
+    {
+        size_type result = 0;
+
+        for ( size_type pos = 0; v.size() <= size() - pos && pos != size(); )
+        {
+            size_type i = 0;
+
+            while ( i != v.size() && Traits::eq( data_[pos + i], v[i] ) )
+                ++i;
+
+            if ( i == v.size() )
+            {
+                ++result;
+                pos += (std::max)( v.size(), size_type( 1 ) );
+            }
+            else
+            {
+                ++pos;
+            }
+        }
+        return result;
+    }
+
+    // constant evaluation of find_first_not_of(), find_last_not_of(), pos < size():
+
+    nssv_constexpr14 bool holds( CharT c ) const nssv_noexcept
+    {
+        for ( size_type i = 0; i != size(); ++i )
+        {
+            if ( Traits::eq( data_[i], c ) )
+                return true;
+        }
+        return false;
+    }
+
+    nssv_constexpr14 size_type first_not_of( basic_string_view v, size_type pos ) const nssv_noexcept
+    {
+        for ( ; pos != size(); ++pos )
+        {
+            if ( ! v.holds( data_[pos] ) )
+                return pos;
+        }
+        return npos;
+    }
+
+    nssv_constexpr14 size_type last_not_of( basic_string_view v, size_type pos ) const nssv_noexcept
+    {
+        for ( ++pos; pos-- != 0; )
+        {
+            if ( ! v.holds( data_[pos] ) )
+                return pos;
+        }
+        return npos;
+    }
+
+    nssv_constexpr size_type to_pos( const_iterator it ) const
+    {
+        return it == cend() ? npos : size_type( it - cbegin() );
+    }
+
+    nssv_constexpr size_type to_pos( const_reverse_iterator it ) const
+    {
+        return it == crend() ? npos : size_type( crend() - it - 1 );
+    }
+
+    // position of index idx relative to position pos, or npos:
+
+    static nssv_constexpr size_type to_pos( size_type pos, size_type idx ) nssv_noexcept
+    {
+        return idx == detail::npos ? npos : pos + idx;
+    }
+
+    nssv_constexpr const_reference data_at( size_type pos ) const
+    {
+#if nssv_BETWEEN( nssv_COMPILER_GNUC_VERSION, 1, 500 )
+        return data_[pos];
+#else
+        return assert( pos < size() ), data_[pos];
+#endif
+    }
+
+private:
+    const_pointer data_;
+    size_type     size_;
+
+public:
+#if nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
+
+    template< class Allocator >
+    basic_string_view( std::basic_string<CharT, Traits, Allocator> const & s ) nssv_noexcept
+        : data_( s.data() )
+        , size_( s.size() )
+    {}
+
+#if nssv_HAVE_EXPLICIT_CONVERSION
+
+    template< class Allocator >
+    explicit operator std::basic_string<CharT, Traits, Allocator>() const
+    {
+        return to_string( Allocator() );
+    }
+
+#endif // nssv_HAVE_EXPLICIT_CONVERSION
+
+#if nssv_CPP11_OR_GREATER
+
+    template< class Allocator = std::allocator<CharT> >
+    std::basic_string<CharT, Traits, Allocator>
+    to_string( Allocator const & a = Allocator() ) const
+    {
+        return std::basic_string<CharT, Traits, Allocator>( begin(), end(), a );
+    }
+
+#else
+
+    std::basic_string<CharT, Traits>
+    to_string() const
+    {
+        return std::basic_string<CharT, Traits>( begin(), end() );
+    }
+
+    template< class Allocator >
+    std::basic_string<CharT, Traits, Allocator>
+    to_string( Allocator const & a ) const
+    {
+        return std::basic_string<CharT, Traits, Allocator>( begin(), end(), a );
+    }
+
+#endif // nssv_CPP11_OR_GREATER
+
+#endif // nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
+};
+
+//
+// Non-member functions:
+//
+
+namespace detail {
+
+// equality of [a, a + n) and [b, b + n) outside constant evaluation:
+
+template< class Traits, typename CharT >
+inline bool equal_chars( CharT const * a, CharT const * b, std::size_t n, false_type /*char*/ )
+{
+    return compare_n<Traits>( a, b, n ) == 0;
+}
+
+// for char, sizes up to 32 via one or two overlapping loads per view,
+// and a view compares equal to itself:
+
+template< class Traits >
+inline bool equal_chars( char const * a, char const * b, std::size_t n, true_type /*char*/ )
+{
+    if ( a == b )
+    {
+        return true;
+    }
+#if nssv_HAVE_SSE2
+    if ( n >= 16 && n <= 32 )
+    {
+        return movemask( _mm_and_si128(
+            _mm_cmpeq_epi8( load128( a          ), load128( b          ) ),
+            _mm_cmpeq_epi8( load128( a + n - 16 ), load128( b + n - 16 ) ) ) ) == 0xffffu;
+    }
+    if ( n >= 8 && n < 16 )
+    {
+        return movemask( _mm_cmpeq_epi8(
+            _mm_unpacklo_epi64( _mm_loadl_epi64( reinterpret_cast<__m128i const *>( a ) ), _mm_loadl_epi64( reinterpret_cast<__m128i const *>( a + n - 8 ) ) ),
+            _mm_unpacklo_epi64( _mm_loadl_epi64( reinterpret_cast<__m128i const *>( b ) ), _mm_loadl_epi64( reinterpret_cast<__m128i const *>( b + n - 8 ) ) ) ) ) == 0xffffu;
+    }
+#endif
+    if ( n >= 4 && n < 8 && sizeof(unsigned) == 4 )
+    {
+        unsigned a0, a1, b0, b1;
+        std::memcpy( &a0, a, 4 ); std::memcpy( &a1, a + n - 4, 4 );
+        std::memcpy( &b0, b, 4 ); std::memcpy( &b1, b + n - 4, 4 );
+        return ( ( a0 ^ b0 ) | ( a1 ^ b1 ) ) == 0;
+    }
+    if ( n < 4 )
+    {
+        return n == 0 || ( a[0] == b[0] && a[n / 2] == b[n / 2] && a[n - 1] == b[n - 1] );
+    }
+    return std::memcmp( a, b, n ) == 0;
+}
+
+template< class Traits, typename CharT >
+inline bool equal_chars( CharT const * a, CharT const * b, std::size_t n )
+{
+    return equal_chars<Traits>( a, b, n, bool_constant< is_std_char_traits<CharT, Traits>::value && sizeof(CharT) == 1 >() );
+}
+
+template< class CharT, class Traits >
+inline nssv_constexpr bool views_equal( basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{
+    return lhs.size() == rhs.size() && ( nssv_is_constant_evaluated()
+        ? lhs.compare( rhs ) == 0
+        : equal_chars<Traits>( lhs.data(), rhs.data(), lhs.size() ) );
+}
+
+} // namespace detail
+
+// 24.4.3 Non-member comparison functions:
+// lexicographically compare two string views (function template):
+
+#if nssv_HAVE_THREE_WAY_COMPARISON
+
+// C++20: the compiler rewrites !=, <, <=, > and >= in terms of == and <=>,
+// also with the operands swapped, so that a single comparison suffices.
+// The second parameter is a non-deduced context to accept an object t with
+// an implicit conversion to basic_string_view<CharT, Traits>:
+
+namespace detail {
+
+template< class Traits, class = void >
+struct comparison_category { typedef std::weak_ordering type; };
+
+template< class Traits >
+struct comparison_category< Traits, std::void_t< typename Traits::comparison_category > >
+{ typedef typename Traits::comparison_category type; };
+
+} // namespace detail
+
+template< class CharT, class Traits >
+constexpr bool operator==(
+    basic_string_view<CharT, Traits> lhs,
+    typename detail::identity< basic_string_view<CharT, Traits> >::type rhs ) noexcept
+{ return detail::views_equal( lhs, rhs ); }
+
+template< class CharT, class Traits >
+constexpr typename detail::comparison_category<Traits>::type operator<=>(
+    basic_string_view<CharT, Traits> lhs,
+    typename detail::identity< basic_string_view<CharT, Traits> >::type rhs ) noexcept
+{ return static_cast< typename detail::comparison_category<Traits>::type >( lhs.compare( rhs ) <=> 0 ); }
+
+#else // nssv_HAVE_THREE_WAY_COMPARISON
+
+template< class CharT, class Traits >
+nssv_constexpr bool operator== (
+    basic_string_view <CharT, Traits> lhs,
+    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
+{ return detail::views_equal( lhs, rhs ); }
+
+template< class CharT, class Traits >
+nssv_constexpr bool operator!= (
+    basic_string_view <CharT, Traits> lhs,
+    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+template< class CharT, class Traits >
+nssv_constexpr bool operator< (
+    basic_string_view <CharT, Traits> lhs,
+    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) < 0; }
+
+template< class CharT, class Traits >
+nssv_constexpr bool operator<= (
+    basic_string_view <CharT, Traits> lhs,
+    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) <= 0; }
+
+template< class CharT, class Traits >
+nssv_constexpr bool operator> (
+    basic_string_view <CharT, Traits> lhs,
+    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) > 0; }
+
+template< class CharT, class Traits >
+nssv_constexpr bool operator>= (
+    basic_string_view <CharT, Traits> lhs,
+    basic_string_view <CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) >= 0; }
+
+// Let S be basic_string_view<CharT, Traits>, and sv be an instance of S.
+// Implementations shall provide sufficient additional overloads marked
+// constexpr and noexcept so that an object t with an implicit conversion
+// to S can be compared according to Table 67.
+
+#if ! nssv_CPP11_OR_GREATER || nssv_BETWEEN( nssv_COMPILER_MSVC_VERSION, 100, 141 )
+
+// accommodate for older compilers:
+
+// ==
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator==(
+    basic_string_view<CharT, Traits> lhs,
+    CharT const * rhs ) nssv_noexcept
+{ return detail::views_equal( lhs, basic_string_view<CharT, Traits>( rhs ) ); }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator==(
+    CharT const * lhs,
+    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{ return detail::views_equal( basic_string_view<CharT, Traits>( lhs ), rhs ); }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator==(
+    basic_string_view<CharT, Traits> lhs,
+    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
+{ return detail::views_equal( lhs, basic_string_view<CharT, Traits>( rhs ) ); }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator==(
+    std::basic_string<CharT, Traits> rhs,
+    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
+{ return detail::views_equal( lhs, basic_string_view<CharT, Traits>( rhs ) ); }
+
+// !=
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator!=(
+    basic_string_view<CharT, Traits> lhs,
+    CharT const * rhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator!=(
+    CharT const * lhs,
+    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator!=(
+    basic_string_view<CharT, Traits> lhs,
+    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator!=(
+    std::basic_string<CharT, Traits> rhs,
+    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+// <
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<(
+    basic_string_view<CharT, Traits> lhs,
+    CharT const * rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) < 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<(
+    CharT const * lhs,
+    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{ return rhs.compare( lhs ) > 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<(
+    basic_string_view<CharT, Traits> lhs,
+    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) < 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<(
+    std::basic_string<CharT, Traits> rhs,
+    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
+{ return rhs.compare( lhs ) > 0; }
+
+// <=
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<=(
+    basic_string_view<CharT, Traits> lhs,
+    CharT const * rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) <= 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<=(
+    CharT const * lhs,
+    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{ return rhs.compare( lhs ) >= 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<=(
+    basic_string_view<CharT, Traits> lhs,
+    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) <= 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator<=(
+    std::basic_string<CharT, Traits> rhs,
+    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
+{ return rhs.compare( lhs ) >= 0; }
+
+// >
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>(
+    basic_string_view<CharT, Traits> lhs,
+    CharT const * rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) > 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>(
+    CharT const * lhs,
+    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{ return rhs.compare( lhs ) < 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>(
+    basic_string_view<CharT, Traits> lhs,
+    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) > 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>(
+    std::basic_string<CharT, Traits> rhs,
+    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
+{ return rhs.compare( lhs ) < 0; }
+
+// >=
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>=(
+    basic_string_view<CharT, Traits> lhs,
+    CharT const * rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) >= 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>=(
+    CharT const * lhs,
+    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
+{ return rhs.compare( lhs ) <= 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>=(
+    basic_string_view<CharT, Traits> lhs,
+    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) >= 0; }
+
+template< class CharT, class Traits>
+nssv_constexpr bool operator>=(
+    std::basic_string<CharT, Traits> rhs,
+    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
+{ return rhs.compare( lhs ) <= 0; }
+
+#else // newer compilers:
+
+#define nssv_BASIC_STRING_VIEW_I(T,U)  typename std::decay< basic_string_view<T,U> >::type
+
+#if defined(_MSC_VER)       // issue 40
+# define nssv_MSVC_ORDER(x)  , int=x
+#else
+# define nssv_MSVC_ORDER(x)  /*, int=x*/
+#endif
+
+// ==
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
+nssv_constexpr bool operator==(
+         basic_string_view  <CharT, Traits> lhs,
+    nssv_BASIC_STRING_VIEW_I(CharT, Traits) rhs ) nssv_noexcept
+{ return detail::views_equal( lhs, rhs ); }
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
+nssv_constexpr bool operator==(
+    nssv_BASIC_STRING_VIEW_I(CharT, Traits) lhs,
+         basic_string_view  <CharT, Traits> rhs ) nssv_noexcept
+{ return detail::views_equal( lhs, rhs ); }
+
+// !=
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
+nssv_constexpr bool operator!= (
+         basic_string_view  < CharT, Traits > lhs,
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
+nssv_constexpr bool operator!= (
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
+         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
+{ return !( lhs == rhs ); }
+
+// <
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
+nssv_constexpr bool operator< (
+         basic_string_view  < CharT, Traits > lhs,
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) < 0; }
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
+nssv_constexpr bool operator< (
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
+         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) < 0; }
+
+// <=
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
+nssv_constexpr bool operator<= (
+         basic_string_view  < CharT, Traits > lhs,
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) <= 0; }
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
+nssv_constexpr bool operator<= (
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
+         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) <= 0; }
+
+// >
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
+nssv_constexpr bool operator> (
+         basic_string_view  < CharT, Traits > lhs,
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) > 0; }
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
+nssv_constexpr bool operator> (
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
+         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) > 0; }
+
+// >=
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
+nssv_constexpr bool operator>= (
+         basic_string_view  < CharT, Traits > lhs,
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) >= 0; }
+
+template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
+nssv_constexpr bool operator>= (
+    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
+         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
+{ return lhs.compare( rhs ) >= 0; }
+
+#undef nssv_MSVC_ORDER
+#undef nssv_BASIC_STRING_VIEW_I
+
+#endif // compiler-dependent approach to comparisons
+
+#endif // nssv_HAVE_THREE_WAY_COMPARISON
+
+// 24.4.4 Inserters and extractors:
+
+#if ! nssv_CONFIG_NO_STREAM_INSERTION
+
+namespace detail {
+
+template< class Stream >
+void write_padding( Stream & os, std::streamsize n )
+{
+    for ( std::streamsize i = 0; i < n; ++i )
+        os.rdbuf()->sputc( os.fill() );
+}
+
+template< class Stream, class View >
+Stream & write_to_stream( Stream & os, View const & sv )
+{
+    typename Stream::sentry sentry( os );
+
+    if ( !sentry )
+        return os;
+
+    const std::streamsize length = static_cast<std::streamsize>( sv.length() );
+
+    // Whether, and how, to pad:
+    const bool      pad = ( length < os.width() );
+    const bool left_pad = pad && ( os.flags() & std::ios_base::adjustfield ) == std::ios_base::right;
+
+    if ( left_pad )
+        write_padding( os, os.width() - length );
+
+    // Write span characters:
+    os.rdbuf()->sputn( sv.begin(), length );
+
+    if ( pad && !left_pad )
+        write_padding( os, os.width() - length );
+
+    // Reset output stream width:
+    os.width( 0 );
+
+    return os;
+}
+
+} // namespace detail
+
+template< class CharT, class Traits >
+std::basic_ostream<CharT, Traits> &
+operator<<(
+    std::basic_ostream<CharT, Traits>& os,
+    basic_string_view <CharT, Traits> sv )
+{
+    return detail::write_to_stream( os, sv );
+}
+
+#endif // nssv_CONFIG_NO_STREAM_INSERTION
+
+// Several typedefs for common character types are provided:
+
+typedef basic_string_view<char>      string_view;
+typedef basic_string_view<wchar_t>   wstring_view;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_string_view<char16_t>  u16string_view;
+typedef basic_string_view<char32_t>  u32string_view;
+#endif
+
+//
+// Searcher for repeated lookup of the same needle (extension):
+//
+
+// Boyer-Moore-Horspool, with the skip table indexed by the low byte of
+// a character. Once verification work exceeds a multiple of the scanned
+// length, switch to Two-Way to keep the worst case linear. The needle's
+// characters must outlive the searcher.
+
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_searcher
+{
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+    typedef typename view_type::const_iterator const_iterator;
+
+    explicit basic_searcher( view_type needle ) nssv_noexcept
+        : needle_( needle )
+        , suffix_( 0 )
+        , period_( 0 )
+    {
+        const size_type m = needle_.size();
+
+        for ( size_type i = 0; i != table_size; ++i )
+        {
+            skip_[i] = (std::max)( m, size_type( 1 ) );
+        }
+
+        for ( size_type i = 0; i + 1 < m; ++i )
+        {
+            skip_[ bucket( needle_[i] ) ] = m - 1 - i;
+        }
+
+        if ( m > 0 )
+        {
+            suffix_ = detail::critical_factorization<Traits>( needle_.data(), m, period_ );
+        }
+    }
+
+    nssv_constexpr view_type needle() const nssv_noexcept
+    {
+        return needle_;
+    }
+
+    // position of the needle in haystack, as haystack.find( needle(), pos ):
+
+    size_type find( view_type haystack, size_type pos = 0 ) const nssv_noexcept
+    {
+        return pos >= haystack.size()
+            ? npos
+            : to_pos( pos, search( haystack.data() + pos, haystack.size() - pos ) );
+    }
+
+    // searcher interface of std::search(), C++17:
+
+    std::pair<const_iterator, const_iterator> operator()( const_iterator first, const_iterator last ) const nssv_noexcept
+    {
+        const size_type idx = search( first, static_cast<size_type>( last - first ) );
+
+        return idx == detail::npos
+            ? std::make_pair( last, last )
+            : std::make_pair( first + idx, first + idx + needle_.size() );
+    }
+
+#if nssv_CPP17_OR_GREATER
+    static nssv_constexpr size_type npos = view_type::npos;
+#elif nssv_CPP11_OR_GREATER
+    enum : size_type { npos = view_type::npos };
+#else
+    enum { npos = view_type::npos };
+#endif
+
+private:
+    enum { table_size = 256 };
+
+    static size_type bucket( CharT c ) nssv_noexcept
+    {
+        return static_cast<unsigned char>( c );
+    }
+
+    static size_type to_pos( size_type pos, size_type idx ) nssv_noexcept
+    {
+        return idx == detail::npos ? npos : pos + idx;
+    }
+
+    size_type search( CharT const * s, size_type n ) const
+    {
+        const CharT * const p = needle_.data();
+        const size_type     m = needle_.size();
+
+        if ( m == 0 ) return 0;
+        if ( m >  n ) return detail::npos;
+
+        // the skip table requires equality under Traits to imply equal buckets:
+
+        if ( m < 4 || ! detail::is_std_char_traits<CharT, Traits>::value )
+        {
+            return detail::find_string<Traits>( s, n, p, m );
+        }
+
+        const CharT last = p[m - 1];
+        size_type work = 0;
+
+        for ( size_type i = 0; i + m <= n; )
+        {
+            const CharT c = s[i + m - 1];
+
+            if ( Traits::eq( c, last ) )
+            {
+                if ( Traits::compare( s + i, p, m - 1 ) == 0 )
+                {
+                    return i;
+                }
+                work += m;
+
+                if ( work > 8 * i + 1024 )
+                {
+                    return detail::add_pos( i, detail::two_way_search<Traits>( s + i, n - i, p, m, suffix_, period_ ) );
+                }
+            }
+            i += skip_[ bucket( c ) ];
+        }
+        return detail::npos;
+    }
+
+private:
+    view_type needle_;
+    size_type suffix_;
+    size_type period_;
+    size_type skip_[ table_size ];
+};
+
+typedef basic_searcher<char>      searcher;
+typedef basic_searcher<wchar_t>   wsearcher;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_searcher<char16_t>  u16searcher;
+typedef basic_searcher<char32_t>  u32searcher;
+#endif
+
+//
+// Set of characters for find_first_of() and friends (extension):
+//
+
+// Builds the membership table of the characters once, at compile time for
+// a literal in C++14 and later. The characters must outlive the set.
+
+template< class CharT, class Traits >
+class basic_char_set
+{
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+
+    nssv_constexpr14 explicit basic_char_set( view_type chars ) nssv_noexcept
+        : table_( chars.data(), chars.size() )
+    {}
+
+    nssv_constexpr14 explicit basic_char_set( CharT const * s )
+        : table_( s, view_type( s ).size() )
+    {}
+
+    nssv_constexpr14 basic_char_set( CharT const * s, size_type count )
+        : table_( s, count )
+    {}
+
+    nssv_constexpr view_type chars() const nssv_noexcept
+    {
+        return view_type( table_.data(), table_.size() );
+    }
+
+    nssv_constexpr14 bool contains( CharT c ) const nssv_noexcept
+    {
+        return table_.contains( c );
+    }
+
+private:
+    friend class basic_string_view<CharT, Traits>;
+
+    detail::char_table<CharT, Traits> table_;
+};
+
+typedef basic_char_set<char>      char_set;
+typedef basic_char_set<wchar_t>   wchar_set;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_char_set<char16_t>  u16char_set;
+typedef basic_char_set<char32_t>  u32char_set;
+#endif
+
+//
+// Aho-Corasick automaton to search for many needles at once (extension):
+//
+
+// The automaton is deterministic and stored in a flat transition table
+// with a row per state and a column per class of characters; characters
+// that occur in no pattern share a class. A scan takes one table lookup
+// per character. Once built, the searcher is immutable and can be shared
+// between threads. Empty patterns never match.
+
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_multi_searcher
+{
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+
+    // occurrence of pattern number pattern at position pos:
+
+    struct match
+    {
+        size_type pattern;
+        size_type pos;
+    };
+
+    template< class InputIt >
+    basic_multi_searcher( InputIt first, InputIt last )
+    {
+        std::vector<view_type> patterns;
+
+        for ( ; first != last; ++first )
+        {
+            patterns.push_back( view_type( *first ) );
+        }
+        build( patterns );
+    }
+
+#if nssv_HAVE_INITIALIZER_LIST
+    basic_multi_searcher( std::initializer_list<view_type> patterns )
+    {
+        build( std::vector<view_type>( patterns.begin(), patterns.end() ) );
+    }
+#endif
+
+    // number of patterns, and length of pattern number id:
+
+    size_type size() const nssv_noexcept
+    {
+        return length_.size();
+    }
+
+    size_type length( size_type id ) const
+    {
+        return length_[id];
+    }
+
+    // first match that ends in haystack, starting at or after pos;
+    // of the patterns that end there, the longest, then lowest id.
+    // pattern and pos are npos if there is no match:
+
+    match find( view_type haystack, size_type pos = 0 ) const
+    {
+        state_type s = 0;
+
+        for ( size_type i = pos; i < haystack.size(); ++i )
+        {
+            s = delta_[ ( s & ~report_bit ) + char_class( haystack[i] ) ];
+
+            if ( s & report_bit )
+            {
+                const state_type u = first_output( s );
+                const size_type  id = out_ids_[ out_offset_[u] ];
+                const match m = { id, i + 1 - length_[id] };
+                return m;
+            }
+        }
+        const match none = { npos, npos };
+        return none;
+    }
+
+    // call f( pattern, pos ) for all matches in the order of their end;
+    // of the patterns that end at the same position, longest first:
+
+    template< class F >
+    F find_all( view_type haystack, F f ) const
+    {
+        state_type s = 0;
+
+        for ( size_type i = 0; i != haystack.size(); ++i )
+        {
+            s = delta_[ ( s & ~report_bit ) + char_class( haystack[i] ) ];
+
+            if ( s & report_bit )
+            {
+                for ( state_type u = state_of( s ); u != 0; u = dict_[u] )
+                {
+                    for ( size_type k = out_offset_[u]; k != out_offset_[u + 1]; ++k )
+                    {
+                        f( out_ids_[k], i + 1 - length_[ out_ids_[k] ] );
+                    }
+                }
+            }
+        }
+        return f;
+    }
+
+#if nssv_CPP17_OR_GREATER
+    static nssv_constexpr size_type npos = view_type::npos;
+#elif nssv_CPP11_OR_GREATER
+    enum : size_type { npos = view_type::npos };
+#else
+    enum { npos = view_type::npos };
+#endif
+
+private:
+    typedef unsigned state_type;
+
+    // transitions hold the target's row offset, with report_bit set
+    // if the target, or one of its suffixes, ends a pattern:
+
+    static const state_type report_bit = state_type( 1 ) << ( std::numeric_limits<state_type>::digits - 1 );
+    static const state_type no_state   = state_type( -1 );
+
+    state_type state_of( state_type s ) const
+    {
+        return ( s & ~report_bit ) / classes_;
+    }
+
+    // state that ends the longest pattern for s:
+
+    state_type first_output( state_type s ) const
+    {
+        const state_type u = state_of( s );
+        return out_offset_[u] != out_offset_[u + 1] ? u : dict_[u];
+    }
+
+    // class of a character, 0 for characters outside the patterns:
+
+    size_type char_class( CharT c ) const
+    {
+        return char_class( c, detail::is_std_char_traits<CharT, Traits>() );
+    }
+
+    size_type char_class( CharT c, detail::true_type /*std*/ ) const
+    {
+        const unsigned long v = detail::char_value( c );
+
+        if ( v < 256 )
+        {
+            return byte_class_[v];
+        }
+
+        typename std::vector<unsigned long>::const_iterator pos =
+            std::lower_bound( wide_.begin(), wide_.end(), v );
+
+        return pos != wide_.end() && *pos == v ? wide_base_ + size_type( pos - wide_.begin() ) : 0;
+    }
+
+    size_type char_class( CharT c, detail::false_type /*std*/ ) const
+    {
+        for ( size_type k = 0; k != other_.size(); ++k )
+        {
+            if ( Traits::eq( other_[k], c ) )
+            {
+                return 1 + k;
+            }
+        }
+        return 0;
+    }
+
+    // classes: for the standard character types, characters below 256 have
+    // their own class, wider characters are numbered from 256 on. For other
+    // traits, characters that compare equal under Traits share a class.
+
+    void make_classes( std::vector<view_type> const & patterns, detail::true_type /*std*/ )
+    {
+        std::vector<bool> used( 256, false );
+
+        for ( size_type p = 0; p != patterns.size(); ++p )
+        {
+            for ( size_type i = 0; i != patterns[p].size(); ++i )
+            {
+                const unsigned long v = detail::char_value( patterns[p][i] );
+
+                if ( v < 256 ) used[v] = true;
+                else           wide_.push_back( v );
+            }
+        }
+
+        std::sort( wide_.begin(), wide_.end() );
+        wide_.erase( std::unique( wide_.begin(), wide_.end() ), wide_.end() );
+
+        // number the byte classes densely, then renumber the wide ones:
+
+        size_type k = 1;
+        for ( size_type v = 0; v != 256; ++v )
+        {
+            byte_class_[v] = static_cast<unsigned short>( used[v] ? k++ : 0 );
+        }
+        wide_base_ = k;
+        classes_   = static_cast<state_type>( k + wide_.size() );
+    }
+
+    void make_classes( std::vector<view_type> const & patterns, detail::false_type /*std*/ )
+    {
+        for ( size_type p = 0; p != patterns.size(); ++p )
+        {
+            for ( size_type i = 0; i != patterns[p].size(); ++i )
+            {
+                if ( char_class( patterns[p][i] ) == 0 )
+                {
+                    other_.push_back( patterns[p][i] );
+                }
+            }
+        }
+        wide_base_ = 0;
+        classes_   = static_cast<state_type>( 1 + other_.size() );
+    }
+
+    void build( std::vector<view_type> const & patterns )
+    {
+        make_classes( patterns, detail::is_std_char_traits<CharT, Traits>() );
+
+        const size_type k = classes_;
+
+        // trie of the patterns, with transitions as state numbers:
+
+        std::vector<state_type> ends;
+
+        add_state();
+
+        for ( size_type p = 0; p != patterns.size(); ++p )
+        {
+            state_type s = 0;
+
+            for ( size_type i = 0; i != patterns[p].size(); ++i )
+            {
+                const size_type e = s * k + char_class( patterns[p][i] );
+
+                if ( delta_[e] == no_state )
+                {
+                    const state_type t = add_state();
+                    delta_[e] = t;
+                }
+                s = delta_[e];
+            }
+            ends.push_back( s );
+            length_.push_back( patterns[p].size() );
+        }
+
+        const size_type n = delta_.size() / k;
+
+#if nssv_CONFIG_NO_EXCEPTIONS
+        assert( n <= ( report_bit - 1u ) / k );
+#else
+        if ( n > ( report_bit - 1u ) / k )
+        {
+            throw std::length_error("nonstd::multi_searcher: too many states");
+        }
+#endif
+
+        // pattern numbers per state; the root only ends empty patterns:
+
+        out_offset_.assign( n + 1, 0 );
+
+        for ( size_type p = 0; p != ends.size(); ++p )
+        {
+            if ( ends[p] != 0 )
+                ++out_offset_[ ends[p] + 1 ];
+        }
+
+        for ( size_type s = 0; s != n; ++s )
+        {
+            out_offset_[s + 1] += out_offset_[s];
+        }
+
+        out_ids_.resize( out_offset_[n] );
+        {
+            std::vector<size_type> next( out_offset_.begin(), out_offset_.end() - 1 );
+
+            for ( size_type p = 0; p != ends.size(); ++p )
+            {
+                if ( ends[p] != 0 )
+                    out_ids_[ next[ ends[p] ]++ ] = p;
+            }
+        }
+
+        // complete the transitions breadth-first via the failure links,
+        // and link each state to its longest suffix state that ends a pattern:
+
+        std::vector<state_type> fail( n, 0 );
+        std::vector<state_type> order;
+
+        dict_.assign( n, 0 );
+        order.reserve( n );
+
+        for ( size_type c = 0; c != k; ++c )
+        {
+            if ( delta_[c] == no_state ) delta_[c] = 0;
+            else                         order.push_back( delta_[c] );
+        }
+
+        for ( size_type q = 0; q != order.size(); ++q )
+        {
+            const state_type s = order[q];
+            const state_type f = fail[s];
+
+            dict_[s] = f != 0 && out_offset_[f] != out_offset_[f + 1] ? f : dict_[f];
+
+            for ( size_type c = 0; c != k; ++c )
+            {
+                const state_type t = delta_[ s * k + c ];
+                const state_type u = delta_[ f * k + c ];
+
+                if ( t == no_state )
+                {
+                    delta_[ s * k + c ] = u;
+                }
+                else
+                {
+                    fail[t] = u;
+                    order.push_back( t );
+                }
+            }
+        }
+
+        // transitions as row offsets, flagged if the target reports matches:
+
+        for ( size_type e = 0; e != delta_.size(); ++e )
+        {
+            const state_type t = delta_[e];
+            const bool reports = out_offset_[t] != out_offset_[t + 1] || dict_[t] != 0;
+
+            delta_[e] = static_cast<state_type>( t * k ) | ( reports ? state_type( report_bit ) : 0u );
+        }
+    }
+
+    state_type add_state()
+    {
+        delta_.resize( delta_.size() + classes_, state_type( no_state ) );
+        return static_cast<state_type>( delta_.size() / classes_ - 1 );
+    }
+
+private:
+    std::vector<state_type>     delta_;
+    std::vector<state_type>     dict_;
+    std::vector<size_type>      out_offset_;
+    std::vector<size_type>      out_ids_;
+    std::vector<size_type>      length_;
+    std::vector<unsigned long>  wide_;
+    std::vector<CharT>          other_;
+    unsigned short              byte_class_[256];
+    size_type                   wide_base_;
+    state_type                  classes_;
+};
+
+typedef basic_multi_searcher<char>      multi_searcher;
+typedef basic_multi_searcher<wchar_t>   wmulti_searcher;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_multi_searcher<char16_t>  u16multi_searcher;
+typedef basic_multi_searcher<char32_t>  u32multi_searcher;
+#endif
+
+//
+// Packed searcher for a few short needles at once (extension):
+//
+
+// For up to 8 non-empty needles of char, find candidate positions via SIMD
+// nibble tables on the first 3 characters of the needles, a bucket bit per
+// needle ("Teddy", Hyperscan), and confirm them via compare(). Otherwise,
+// take the leftmost of the needles' find() results. The needles' characters
+// must outlive the searcher.
+
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_packed_searcher
+{
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+
+    // occurrence of needle number pattern at position pos:
+
+    struct match
+    {
+        size_type pattern;
+        size_type pos;
+    };
+
+    template< class InputIt >
+    basic_packed_searcher( InputIt first, InputIt last )
+    {
+        for ( ; first != last; ++first )
+        {
+            needles_.push_back( view_type( *first ) );
+        }
+        build();
+    }
+
+#if nssv_HAVE_INITIALIZER_LIST
+    basic_packed_searcher( std::initializer_list<view_type> needles )
+        : needles_( needles.begin(), needles.end() )
+    {
+        build();
+    }
+#endif
+
+    // number of needles, and needle number id:
+
+    size_type size() const nssv_noexcept
+    {
+        return needles_.size();
+    }
+
+    view_type needle( size_type id ) const
+    {
+        return needles_[id];
+    }
+
+    // leftmost position of any of the needles in haystack, as the least
+    // of haystack.find( needle( id ), pos ):
+
+    size_type find( view_type haystack, size_type pos = 0 ) const
+    {
+        return find_match( haystack, pos ).pos;
+    }
+
+    // as find(), with the lowest number of the needles found there:
+
+    match find_match( view_type haystack, size_type pos = 0 ) const
+    {
+        match m = { npos, npos };
+
+        if ( pos < haystack.size() )
+        {
+            m = packed_
+                ? search( haystack.data() + pos, haystack.size() - pos, detail::bool_constant< detail::use_nibbles<CharT, Traits>::value >() )
+                : search( haystack.data() + pos, haystack.size() - pos, detail::false_type() );
+
+            if ( m.pos != npos )
+            {
+                m.pos += pos;
+            }
+        }
+        return m;
+    }
+
+#if nssv_CPP17_OR_GREATER
+    static nssv_constexpr size_type npos = view_type::npos;
+#elif nssv_CPP11_OR_GREATER
+    enum : size_type { npos = view_type::npos };
+#else
+    enum { npos = view_type::npos };
+#endif
+
+private:
+    enum { max_packed = 8, prefix = 3 };
+
+    void build()
+    {
+        packed_ = detail::use_nibbles<CharT, Traits>::value && ! needles_.empty() && needles_.size() <= max_packed;
+
+        for ( size_type id = 0; id != needles_.size(); ++id )
+        {
+            packed_ = packed_ && ! needles_[id].empty();
+        }
+
+        // nibble tables per prefix position; positions beyond a needle match anything:
+
+        for ( size_type j = 0; j != prefix; ++j )
+        {
+            for ( size_type k = 0; k != 16; ++k )
+            {
+                lo_[j][k] = hi_[j][k] = 0;
+            }
+
+            for ( size_type id = 0; packed_ && id != needles_.size(); ++id )
+            {
+                const unsigned bit = 1u << id;
+
+                if ( j < needles_[id].size() )
+                {
+                    const unsigned long v = detail::char_value( needles_[id][j] );
+
+                    lo_[j][ v & 0xfu ] = static_cast<unsigned char>( lo_[j][ v & 0xfu ] | bit );
+                    hi_[j][ v >> 4   ] = static_cast<unsigned char>( hi_[j][ v >> 4   ] | bit );
+                }
+                else
+                {
+                    for ( size_type k = 0; k != 16; ++k )
+                    {
+                        lo_[j][k] = static_cast<unsigned char>( lo_[j][k] | bit );
+                        hi_[j][k] = static_cast<unsigned char>( hi_[j][k] | bit );
+                    }
+                }
+            }
+        }
+    }
+
+    // does a needle of bucket bits occur at s[i], of [s, s + n)? Lowest number first:
+
+    bool verify( CharT const * s, size_type n, size_type i, unsigned bits, match & m ) const
+    {
+        for ( ; bits != 0; bits &= bits - 1 )
+        {
+            const size_type id = detail::ctz( bits );
+            const view_type & v = needles_[id];
+
+            if ( v.size() <= n - i && v.compare( view_type( s + i, v.size() ) ) == 0 )
+            {
+                m.pattern = id;
+                m.pos     = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // leftmost of the needles' find() results, restricting later searches
+    // to the part of [s, s + n) before the best position so far:
+
+    match search( CharT const * s, size_type n, detail::false_type /*packed*/ ) const
+    {
+        match m = { npos, npos };
+
+        for ( size_type id = 0; id != needles_.size(); ++id )
+        {
+            const view_type & v = needles_[id];
+            const size_type limit = m.pos == npos ? n : (std::min)( n, m.pos - 1 + v.size() );
+            const size_type i = detail::find_string<Traits>( s, limit, v.data(), v.size() );
+
+            if ( i != detail::npos && i < m.pos )
+            {
+                m.pattern = id;
+                m.pos     = i;
+            }
+        }
+        return m;
+    }
+
+#if nssv_HAVE_SSSE3
+
+    match search( CharT const * s, size_type n, detail::true_type /*packed*/ ) const
+    {
+        match m = { npos, npos };
+        size_type i = 0;
+
+        const __m128i lo0 = detail::load128( lo_[0] ), hi0 = detail::load128( hi_[0] );
+        const __m128i lo1 = detail::load128( lo_[1] ), hi1 = detail::load128( hi_[1] );
+        const __m128i lo2 = detail::load128( lo_[2] ), hi2 = detail::load128( hi_[2] );
+
+#if nssv_HAVE_AVX2
+        {
+            const __m256i lo0w = _mm256_broadcastsi128_si256( lo0 ), hi0w = _mm256_broadcastsi128_si256( hi0 );
+            const __m256i lo1w = _mm256_broadcastsi128_si256( lo1 ), hi1w = _mm256_broadcastsi128_si256( hi1 );
+            const __m256i lo2w = _mm256_broadcastsi128_si256( lo2 ), hi2w = _mm256_broadcastsi128_si256( hi2 );
+
+            for ( ; i + 32 + prefix - 1 <= n; i += 32 )
+            {
+                const __m256i r = _mm256_and_si256(
+                    detail::classify( detail::load256( s + i     ), lo0w, hi0w ), _mm256_and_si256(
+                    detail::classify( detail::load256( s + i + 1 ), lo1w, hi1w ),
+                    detail::classify( detail::load256( s + i + 2 ), lo2w, hi2w ) ) );
+
+                unsigned k = ~detail::movemask( _mm256_cmpeq_epi8( r, _mm256_setzero_si256() ) );
+
+                if ( k != 0 )
+                {
+                    unsigned char bits[32];
+                    _mm256_storeu_si256( reinterpret_cast<__m256i *>( bits ), r );
+
+                    for ( ; k != 0; k &= k - 1 )
+                    {
+                        if ( verify( s, n, i + detail::ctz( k ), bits[ detail::ctz( k ) ], m ) )
+                            return m;
+                    }
+                }
+            }
+        }
+#endif
+        for ( ; i + 16 + prefix - 1 <= n; i += 16 )
+        {
+            const __m128i r = _mm_and_si128(
+                detail::classify( detail::load128( s + i     ), lo0, hi0 ), _mm_and_si128(
+                detail::classify( detail::load128( s + i + 1 ), lo1, hi1 ),
+                detail::classify( detail::load128( s + i + 2 ), lo2, hi2 ) ) );
+
+            unsigned k = ~detail::movemask( _mm_cmpeq_epi8( r, _mm_setzero_si128() ) ) & 0xffffu;
+
+            if ( k != 0 )
+            {
+                unsigned char bits[16];
+                _mm_storeu_si128( reinterpret_cast<__m128i *>( bits ), r );
+
+                for ( ; k != 0; k &= k - 1 )
+                {
+                    if ( verify( s, n, i + detail::ctz( k ), bits[ detail::ctz( k ) ], m ) )
+                        return m;
+                }
+            }
+        }
+
+        for ( ; i != n; ++i )
+        {
+            if ( verify( s, n, i, ( 1u << needles_.size() ) - 1u, m ) )
+                return m;
+        }
+        return m;
+    }
+
+#endif // nssv_HAVE_SSSE3
+
+private:
+    std::vector<view_type> needles_;
+    unsigned char lo_[prefix][16];
+    unsigned char hi_[prefix][16];
+    bool packed_;
+};
+
+typedef basic_packed_searcher<char>      packed_searcher;
+typedef basic_packed_searcher<wchar_t>   wpacked_searcher;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_packed_searcher<char16_t>  u16packed_searcher;
+typedef basic_packed_searcher<char32_t>  u32packed_searcher;
+#endif
+
+//
+// Lazy range of the occurrences of a needle (extension):
+//
+
+// find_all( haystack, needle ) enumerates the positions of the needle in
+// haystack in increasing order, without allocation. The iterator keeps the
+// search state between matches, and refers to the range, which must outlive
+// it. The haystack's and the needle's characters must outlive the range.
+
+enum find_mode
+{
+    find_overlapping,       // every occurrence, as repeated find( needle, pos + 1 )
+    find_non_overlapping    // occurrences after the end of the previous one
+};
+
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_match_range
+{
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+
+    basic_match_range( view_type haystack, view_type needle, find_mode mode = find_overlapping ) nssv_noexcept
+        : haystack_( haystack )
+        , p_( needle.data() )
+        , m_( needle.size() )
+        , c_( needle.size() == 1 ? needle[0] : CharT() )
+        , suffix_( 0 )
+        , period_( 0 )
+        , shift_( 1 )
+        , periodic_( false )
+        , mode_( mode )
+    {
+        if ( m_ > 1 )
+        {
+            suffix_   = detail::critical_factorization<Traits>( p_, m_, period_ );
+            periodic_ = detail::equal_n<Traits>( p_, p_ + period_, suffix_ );
+            shift_    = periodic_ ? period_ : (std::max)( suffix_, m_ - suffix_ ) + 1;
+        }
+    }
+
+    basic_match_range( view_type haystack, CharT c, find_mode mode = find_overlapping ) nssv_noexcept
+        : haystack_( haystack )
+        , p_( nssv_nullptr )
+        , m_( 1 )
+        , c_( c )
+        , suffix_( 0 )
+        , period_( 0 )
+        , shift_( 1 )
+        , periodic_( false )
+        , mode_( mode )
+    {}
+
+    view_type haystack() const nssv_noexcept
+    {
+        return haystack_;
+    }
+
+    view_type needle() const nssv_noexcept
+    {
+        return m_ == 1 ? view_type( &c_, 1 ) : view_type( p_, m_ );
+    }
+
+    find_mode mode() const nssv_noexcept
+    {
+        return mode_;
+    }
+
+    class iterator;
+    typedef iterator const_iterator;
+
+    iterator begin() const nssv_noexcept
+    {
+        iterator it( this );
+        it.pos_ = next( 0, it.state_ );
+        return it;
+    }
+
+    iterator end() const nssv_noexcept
+    {
+        return iterator( this );
+    }
+
+    bool empty() const nssv_noexcept
+    {
+        return begin() == end();
+    }
+
+#if nssv_CPP17_OR_GREATER
+    static nssv_constexpr size_type npos = view_type::npos;
+#elif nssv_CPP11_OR_GREATER
+    enum : size_type { npos = view_type::npos };
+#else
+    enum { npos = view_type::npos };
+#endif
+
+    class iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef size_type                 value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef size_type const *         pointer;
+        typedef size_type const &         reference;
+
+        iterator() nssv_noexcept
+            : range_( nssv_nullptr )
+            , pos_( npos )
+            , state_( detail::use_simd<CharT, Traits>::value )
+        {}
+
+        // position of the match in the haystack:
+
+        reference operator*() const nssv_noexcept
+        {
+            return pos_;
+        }
+
+        pointer operator->() const nssv_noexcept
+        {
+            return &pos_;
+        }
+
+        // the match as a view into the haystack:
+
+        view_type view() const nssv_noexcept
+        {
+            return view_type( range_->haystack_.data() + pos_, range_->m_ );
+        }
+
+        iterator & operator++() nssv_noexcept
+        {
+            pos_ = range_->next( range_->advance( pos_, state_ ), state_ );
+            return *this;
+        }
+
+        iterator operator++( int ) nssv_noexcept
+        {
+            iterator tmp( *this );
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==( iterator const & a, iterator const & b ) nssv_noexcept
+        {
+            return a.pos_ == b.pos_;
+        }
+
+        friend bool operator!=( iterator const & a, iterator const & b ) nssv_noexcept
+        {
+            return a.pos_ != b.pos_;
+        }
+
+    private:
+        friend class basic_match_range;
+
+        explicit iterator( basic_match_range const * range ) nssv_noexcept
+            : range_( range )
+            , pos_( npos )
+            , state_( detail::use_simd<CharT, Traits>::value )
+        {}
+
+        basic_match_range const * range_;
+        size_type pos_;
+        detail::search_state state_;
+    };
+
+private:
+    static size_type to_pos( size_type pos, size_type idx ) nssv_noexcept
+    {
+        return idx == detail::npos ? npos : pos + idx;
+    }
+
+    // where to continue after a match at pos; Two-Way skips by the shift
+    // of its factorization and remembers the matched prefix of a periodic
+    // needle:
+
+    size_type advance( size_type pos, detail::search_state & st ) const nssv_noexcept
+    {
+        st.memory = 0;
+
+        if ( mode_ == find_non_overlapping )
+        {
+            return pos + (std::max)( m_, size_type( 1 ) );
+        }
+        if ( m_ > 1 && st.two_way )
+        {
+            st.memory = periodic_ ? m_ - period_ : 0;
+            return pos + shift_;
+        }
+        return pos + 1;
+    }
+
+    // first match at or after j, as haystack.find( needle(), j ):
+
+    size_type next( size_type j, detail::search_state & st ) const nssv_noexcept
+    {
+        const size_type n = haystack_.size();
+
+        if ( j >= n || m_ > n - j )
+        {
+            return npos;
+        }
+        if ( m_ == 0 )
+        {
+            return j;
+        }
+        if ( m_ == 1 )
+        {
+            return to_pos( j, detail::find_char<Traits>( haystack_.data() + j, n - j, c_ ) );
+        }
+        return to_pos( j, detail::resume_search<Traits>( haystack_.data() + j, n - j, p_, m_, suffix_, period_, j, st ) );
+    }
+
+private:
+    view_type haystack_;
+    CharT const * p_;
+    size_type m_;
+    CharT c_;
+    size_type suffix_;
+    size_type period_;
+    size_type shift_;
+    bool periodic_;
+    find_mode mode_;
+};
+
+typedef basic_match_range<char>      match_range;
+typedef basic_match_range<wchar_t>   wmatch_range;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_match_range<char16_t>  u16match_range;
+typedef basic_match_range<char32_t>  u32match_range;
+#endif
+
+// all occurrences of needle, or of character c, in haystack:
+
+template< class CharT, class Traits >
+inline basic_match_range<CharT, Traits>
+find_all(
+    basic_string_view<CharT, Traits> haystack,
+    typename detail::identity< basic_string_view<CharT, Traits> >::type needle,
+    find_mode mode = find_overlapping ) nssv_noexcept
+{
+    return basic_match_range<CharT, Traits>( haystack, needle, mode );
+}
+
+template< class CharT, class Traits >
+inline basic_match_range<CharT, Traits>
+find_all(
+    basic_string_view<CharT, Traits> haystack,
+    CharT c,
+    find_mode mode = find_overlapping ) nssv_noexcept
+{
+    return basic_match_range<CharT, Traits>( haystack, c, mode );
+}
+
+//
+// Seeded 64-bit hash (extension, C++11):
+//
+
+#if nssv_CPP11_OR_GREATER
+
+namespace detail {
+
+typedef std::uint64_t hash_word;
+
+nssv_constexpr hash_word hash_p0  = 0xa0761d6478bd642full;
+nssv_constexpr hash_word hash_p1  = 0xe7037ed1a0b428dbull;
+nssv_constexpr hash_word hash_p2  = 0x8ebc6af09c88c6e3ull;
+nssv_constexpr hash_word hash_p3  = 0x589965cc75374cc3ull;
+nssv_constexpr hash_word hash_p32 = 0x9e3779b1ull;
+
+// initial lanes and secret words of the long-input path:
+
+template< typename T = void >
+struct hash_tables
+{
+    static nssv_constexpr hash_word init[8] =
+    {
+        0x00000000c2b2ae3dull, 0x9e3779b185ebca87ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull,
+        0x85ebca77c2b2ae63ull, 0x0000000085ebca77ull, 0x27d4eb2f165667c5ull, 0x000000009e3779b1ull,
+    };
+
+    static nssv_constexpr hash_word secret[16] =
+    {
+        0x2cb0f69f4abea221ull, 0x9417034723148989ull, 0xdd555950609dfe03ull, 0xdbafb150deb12800ull,
+        0x7e789b2e6c442cb6ull, 0xf41e5636c7e4f8c4ull, 0x0959d150f8fba7e4ull, 0xa97316f13cdb9eeaull,
+        0x74cd8258f9520068ull, 0x55c74a62e116868bull, 0xd2f4c799a2023cbdull, 0xdf98cb79a37b51b9ull,
+        0x396f5885524f3905ull, 0xaf1d56386ca3b276ull, 0xa9ffbe6b5104e85aull, 0x6bd0c51b9fd533b3ull,
+    };
+};
+
+#if ! nssv_CPP17_OR_GREATER
+template< typename T > nssv_constexpr hash_word hash_tables<T>::init[8];
+template< typename T > nssv_constexpr hash_word hash_tables<T>::secret[16];
+#endif
+
+// 128-bit product of a and b as its low and high half:
+
+inline nssv_constexpr14 void hash_mum( hash_word & a, hash_word & b ) nssv_noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 hash_word2;
+
+    const hash_word2 r = static_cast<hash_word2>( a ) * b;
+    a = static_cast<hash_word>( r );
+    b = static_cast<hash_word>( r >> 64 );
+#else
+    const hash_word ha = a >> 32, la = a & 0xffffffffu;
+    const hash_word hb = b >> 32, lb = b & 0xffffffffu;
+    const hash_word rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const hash_word t  = rl + ( rm0 << 32 );
+    const hash_word lo = t + ( rm1 << 32 );
+
+    a = lo;
+    b = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + ( t < rl ) + ( lo < t );
+#endif
+}
+
+inline nssv_constexpr14 hash_word hash_mix( hash_word a, hash_word b ) nssv_noexcept
+{
+    return hash_mum( a, b ), a ^ b;
+}
+
+inline nssv_constexpr14 hash_word hash_avalanche( hash_word h ) nssv_noexcept
+{
+    return h ^= h >> 37, h *= 0x165667919e3779f9ull, h ^ ( h >> 32 );
+}
+
+// little-endian words of the bytes of the characters, from memory on a
+// little-endian machine, and from the characters' values otherwise:
+
+struct hash_memory_reader
+{
+    char const * p;
+
+    unsigned char byte( std::size_t i ) const nssv_noexcept
+    {
+        return static_cast<unsigned char>( p[i] );
+    }
+
+    hash_word read32( std::size_t i ) const nssv_noexcept
+    {
+        std::uint32_t x;
+        return std::memcpy( &x, p + i, sizeof x ), x;
+    }
+
+    hash_word read64( std::size_t i ) const nssv_noexcept
+    {
+        hash_word x;
+        return std::memcpy( &x, p + i, sizeof x ), x;
+    }
+};
+
+template< typename CharT >
+struct hash_value_reader
+{
+    CharT const * s;
+
+    nssv_constexpr14 unsigned char byte( std::size_t i ) const nssv_noexcept
+    {
+        return static_cast<unsigned char>( static_cast<hash_word>(
+            static_cast< typename std::make_unsigned<CharT>::type >( s[ i / sizeof(CharT) ] ) ) >> ( 8 * ( i % sizeof(CharT) ) ) );
+    }
+
+    nssv_constexpr14 hash_word read32( std::size_t i ) const nssv_noexcept
+    {
+        return hash_word( byte( i ) ) | hash_word( byte( i + 1 ) ) << 8 | hash_word( byte( i + 2 ) ) << 16 | hash_word( byte( i + 3 ) ) << 24;
+    }
+
+    nssv_constexpr14 hash_word read64( std::size_t i ) const nssv_noexcept
+    {
+        return read32( i ) | read32( i + 4 ) << 32;
+    }
+};
+
+// up to 256 bytes, as wyhash does: short keys via two words of overlapping
+// reads, longer ones via a 128-bit multiply per 16 bytes, in three lanes:
+
+inline nssv_constexpr14 hash_word hash_seed( hash_word seed ) nssv_noexcept
+{
+    return seed ^ hash_mix( seed ^ hash_p0, hash_p1 );
+}
+
+inline nssv_constexpr14 hash_word hash_final( hash_word a, hash_word b, hash_word s, std::size_t n ) nssv_noexcept
+{
+    a ^= hash_p1;
+    b ^= s;
+    hash_mum( a, b );
+
+    return hash_mix( a ^ hash_p0 ^ n, b ^ hash_p1 );
+}
+
+template< class Reader >
+inline nssv_constexpr14 hash_word hash_short( Reader const & r, std::size_t n, hash_word seed ) nssv_noexcept
+{
+    const std::size_t q = ( n >> 3 ) << 2;
+
+    return n >= 4
+        ? hash_final( r.read32( 0 ) << 32 | r.read32( q ), r.read32( n - 4 ) << 32 | r.read32( n - 4 - q ), hash_seed( seed ), n )
+        : hash_final( n == 0 ? 0 : hash_word( r.byte( 0 ) ) << 16 | hash_word( r.byte( n >> 1 ) ) << 8 | r.byte( n - 1 ), 0, hash_seed( seed ), n );
+}
+
+template< class Reader >
+nssv_constexpr14 hash_word hash_medium( Reader const & r, std::size_t n, hash_word seed ) nssv_noexcept
+{
+    hash_word s = hash_seed( seed );
+    std::size_t i = 0;
+
+    if ( n > 48 )
+    {
+        hash_word s1 = s;
+        hash_word s2 = s;
+
+        for ( ; n - i > 48; i += 48 )
+        {
+            s  = hash_mix( r.read64( i      ) ^ hash_p1, r.read64( i +  8 ) ^ s  );
+            s1 = hash_mix( r.read64( i + 16 ) ^ hash_p2, r.read64( i + 24 ) ^ s1 );
+            s2 = hash_mix( r.read64( i + 32 ) ^ hash_p3, r.read64( i + 40 ) ^ s2 );
+        }
+        s ^= s1 ^ s2;
+    }
+
+    for ( ; n - i > 16; i += 16 )
+    {
+        s = hash_mix( r.read64( i ) ^ hash_p1, r.read64( i + 8 ) ^ s );
+    }
+
+    return hash_final( r.read64( n - 16 ), r.read64( n - 8 ), s, n );
+}
+
+// beyond 256 bytes, as XXH3 does: accumulate 64-byte stripes into eight
+// lanes, each with a 32x32-bit product of the data and a secret word; the
+// secret slides by a word per stripe, and the lanes are scrambled per eight
+// stripes. The scalar lanes define the result, the SIMD lanes reproduce it:
+
+template< class Reader >
+struct hash_lanes
+{
+    Reader r;
+    hash_word acc[8];
+
+    nssv_constexpr14 explicit hash_lanes( Reader reader ) nssv_noexcept
+        : r( reader )
+        , acc{ hash_tables<>::init[0], hash_tables<>::init[1], hash_tables<>::init[2], hash_tables<>::init[3],
+               hash_tables<>::init[4], hash_tables<>::init[5], hash_tables<>::init[6], hash_tables<>::init[7] }
+    {}
+
+    nssv_constexpr14 void stripe( std::size_t i, hash_word const * k ) nssv_noexcept
+    {
+        for ( std::size_t j = 0; j != 8; ++j )
+        {
+            const hash_word v = r.read64( i + 8 * j );
+            const hash_word x = v ^ k[j];
+
+            acc[j ^ 1] += v;
+            acc[j    ] += ( x & 0xffffffffu ) * ( x >> 32 );
+        }
+    }
+
+    nssv_constexpr14 void scramble( hash_word const * k ) nssv_noexcept
+    {
+        for ( std::size_t j = 0; j != 8; ++j )
+        {
+            acc[j] = ( acc[j] ^ ( acc[j] >> 47 ) ^ k[j] ) * hash_p32;
+        }
+    }
+
+    nssv_constexpr14 void store( hash_word * out ) const nssv_noexcept
+    {
+        for ( std::size_t j = 0; j != 8; ++j )
+        {
+            out[j] = acc[j];
+        }
+    }
+};
+
+#if nssv_HAVE_SSE2
+
+#if nssv_HAVE_AVX2
+typedef __m256i hash_vector;
+
+inline hash_vector hash_load   ( void const * p ) { return _mm256_loadu_si256( static_cast<__m256i const *>( p ) ); }
+inline void        hash_store  ( void * p, hash_vector v ) { _mm256_storeu_si256( static_cast<__m256i *>( p ), v ); }
+inline hash_vector hash_add    ( hash_vector a, hash_vector b ) { return _mm256_add_epi64( a, b ); }
+inline hash_vector hash_xor    ( hash_vector a, hash_vector b ) { return _mm256_xor_si256( a, b ); }
+inline hash_vector hash_mul32  ( hash_vector a, hash_vector b ) { return _mm256_mul_epu32( a, b ); }
+inline hash_vector hash_srl    ( hash_vector a, int n ) { return _mm256_srli_epi64( a, n ); }
+inline hash_vector hash_sll    ( hash_vector a, int n ) { return _mm256_slli_epi64( a, n ); }
+inline hash_vector hash_splat32( hash_word x ) { return _mm256_set1_epi32( static_cast<int>( x ) ); }
+# define nssv_HASH_SWAP_HALVES( v )  _mm256_shuffle_epi32( v, 0xb1 )
+# define nssv_HASH_SWAP_WORDS( v )   _mm256_shuffle_epi32( v, 0x4e )
+#else
+typedef __m128i hash_vector;
+
+inline hash_vector hash_load   ( void const * p ) { return _mm_loadu_si128( static_cast<__m128i const *>( p ) ); }
+inline void        hash_store  ( void * p, hash_vector v ) { _mm_storeu_si128( static_cast<__m128i *>( p ), v ); }
+inline hash_vector hash_add    ( hash_vector a, hash_vector b ) { return _mm_add_epi64( a, b ); }
+inline hash_vector hash_xor    ( hash_vector a, hash_vector b ) { return _mm_xor_si128( a, b ); }
+inline hash_vector hash_mul32  ( hash_vector a, hash_vector b ) { return _mm_mul_epu32( a, b ); }
+inline hash_vector hash_srl    ( hash_vector a, int n ) { return _mm_srli_epi64( a, n ); }
+inline hash_vector hash_sll    ( hash_vector a, int n ) { return _mm_slli_epi64( a, n ); }
+inline hash_vector hash_splat32( hash_word x ) { return _mm_set1_epi32( static_cast<int>( x ) ); }
+# define nssv_HASH_SWAP_HALVES( v )  _mm_shuffle_epi32( v, 0xb1 )
+# define nssv_HASH_SWAP_WORDS( v )   _mm_shuffle_epi32( v, 0x4e )
+#endif
+
+struct hash_lanes_simd
+{
+    enum { count = 64 / sizeof(hash_vector) };
+
+    char const * p;
+    hash_vector acc[count];
+
+    explicit hash_lanes_simd( char const * data ) nssv_noexcept
+        : p( data )
+    {
+        for ( std::size_t j = 0; j != count; ++j )
+        {
+            acc[j] = hash_load( hash_tables<>::init + j * sizeof(hash_vector) / 8 );
+        }
+    }
+
+    // acc[j ^ 1] += v: swap the words; acc[j] += lo(x) * hi(x): swap the halves of each word:
+
+    void stripe( std::size_t i, hash_word const * k ) nssv_noexcept
+    {
+        for ( std::size_t j = 0; j != count; ++j )
+        {
+            const hash_vector v = hash_load( p + i + j * sizeof(hash_vector) );
+            const hash_vector x = hash_xor( v, hash_load( k + j * sizeof(hash_vector) / 8 ) );
+
+            acc[j] = hash_add( acc[j], hash_add( nssv_HASH_SWAP_WORDS( v ), hash_mul32( x, nssv_HASH_SWAP_HALVES( x ) ) ) );
+        }
+    }
+
+    // acc * p32 as lo(acc) * p32 + ( hi(acc) * p32 << 32 ):
+
+    void scramble( hash_word const * k ) nssv_noexcept
+    {
+        const hash_vector prime = hash_splat32( hash_p32 );
+
+        for ( std::size_t j = 0; j != count; ++j )
+        {
+            const hash_vector a = hash_xor( hash_xor( acc[j], hash_srl( acc[j], 47 ) ), hash_load( k + j * sizeof(hash_vector) / 8 ) );
+
+            acc[j] = hash_add( hash_mul32( a, prime ), hash_sll( hash_mul32( hash_srl( a, 32 ), prime ), 32 ) );
+        }
+    }
+
+    void store( hash_word * out ) const nssv_noexcept
+    {
+        for ( std::size_t j = 0; j != count; ++j )
+        {
+            hash_store( out + j * sizeof(hash_vector) / 8, acc[j] );
+        }
+    }
+};
+
+#undef nssv_HASH_SWAP_HALVES
+#undef nssv_HASH_SWAP_WORDS
+
+#endif // nssv_HAVE_SSE2
+
+// secret words, perturbed by the seed:
+
+inline nssv_constexpr14 void hash_keys( hash_word * ks, hash_word seed ) nssv_noexcept
+{
+    for ( std::size_t i = 0; i != 16; ++i )
+    {
+        ks[i] = i % 2 == 0 ? hash_tables<>::secret[i] + seed : hash_tables<>::secret[i] - seed;
+    }
+}
+
+template< class Lanes >
+nssv_constexpr14 hash_word hash_long( Lanes & lanes, std::size_t n, hash_word const * ks ) nssv_noexcept
+{
+    const std::size_t block  = 8 * 64;
+    const std::size_t blocks = ( n - 1 ) / block;
+
+    for ( std::size_t b = 0; b != blocks; ++b )
+    {
+        for ( std::size_t i = 0; i != 8; ++i )
+        {
+            lanes.stripe( b * block + i * 64, ks + i );
+        }
+        lanes.scramble( ks + 8 );
+    }
+
+    // the remaining whole stripes, except the last, and the last 64 bytes:
+
+    const std::size_t stripes = ( n - 1 - blocks * block ) / 64;
+
+    for ( std::size_t i = 0; i != stripes; ++i )
+    {
+        lanes.stripe( blocks * block + i * 64, ks + i );
+    }
+    lanes.stripe( n - 64, ks + 7 );
+
+    hash_word acc[8] = {};
+    lanes.store( acc );
+
+    hash_word h = n * hash_p0;
+
+    for ( std::size_t j = 0; j != 8; j += 2 )
+    {
+        h += hash_mix( acc[j] ^ ks[j + 1], acc[j + 1] ^ ks[j + 2] );
+    }
+    return hash_avalanche( h );
+}
+
+// hash of the n bytes that the reader yields, in constant evaluation, or at
+// run time of characters in memory:
+
+template< class Reader >
+nssv_constexpr14 hash_word hash_bytes( Reader const & r, std::size_t n, hash_word seed ) nssv_noexcept
+{
+    if ( n <= 16 )
+    {
+        return hash_short( r, n, seed );
+    }
+    if ( n <= 256 )
+    {
+        return hash_medium( r, n, seed );
+    }
+
+    hash_word ks[16] = {};
+    hash_keys( ks, seed );
+
+    hash_lanes<Reader> lanes( r );
+    return hash_long( lanes, n, ks );
+}
+
+inline nssv_NOINLINE hash_word hash_memory_medium( char const * p, std::size_t n, hash_word seed ) nssv_noexcept
+{
+    return hash_medium( hash_memory_reader{ p }, n, seed );
+}
+
+inline nssv_NOINLINE hash_word hash_memory_long( char const * p, std::size_t n, hash_word seed ) nssv_noexcept
+{
+    hash_word ks[16] = {};
+    hash_keys( ks, seed );
+
+#if nssv_HAVE_SSE2
+    hash_lanes_simd lanes( p );
+#else
+    hash_lanes<hash_memory_reader> lanes( hash_memory_reader{ p } );
+#endif
+    return hash_long( lanes, n, ks );
+}
+
+inline hash_word hash_bytes( char const * p, std::size_t n, hash_word seed ) nssv_noexcept
+{
+    if ( n <= 16 )
+    {
+        return hash_short( hash_memory_reader{ p }, n, seed );
+    }
+    return n <= 256 ? hash_memory_medium( p, n, seed ) : hash_memory_long( p, n, seed );
+}
+
+} // namespace detail
+
+// seeded 64-bit hash of the characters of a view, as of the little-endian
+// bytes of their values; the output is the same on every platform:
+
+template< class CharT, class Traits >
+inline nssv_constexpr14 std::uint64_t sv_hash( basic_string_view<CharT, Traits> v, std::uint64_t seed = 0 ) nssv_noexcept
+{
+    return nssv_is_constant_evaluated14() || ! nssv_HAVE_LITTLE_ENDIAN
+        ? detail::hash_bytes( detail::hash_value_reader<CharT>{ v.data() }, v.size() * sizeof(CharT), seed )
+        : detail::hash_bytes( reinterpret_cast<char const *>( v.data() ), v.size() * sizeof(CharT), seed );
+}
+
+inline nssv_constexpr14 std::uint64_t sv_hash( string_view v, std::uint64_t seed = 0 ) nssv_noexcept
+{
+    return sv_hash<char, std::char_traits<char> >( v, seed );
+}
+
+inline nssv_constexpr14 std::uint64_t sv_hash( wstring_view v, std::uint64_t seed = 0 ) nssv_noexcept
+{
+    return sv_hash<wchar_t, std::char_traits<wchar_t> >( v, seed );
+}
+
+#if nssv_HAVE_WCHAR16_T
+inline nssv_constexpr14 std::uint64_t sv_hash( u16string_view v, std::uint64_t seed = 0 ) nssv_noexcept
+{
+    return sv_hash<char16_t, std::char_traits<char16_t> >( v, seed );
+}
+#endif
+
+#if nssv_HAVE_WCHAR32_T
+inline nssv_constexpr14 std::uint64_t sv_hash( u32string_view v, std::uint64_t seed = 0 ) nssv_noexcept
+{
+    return sv_hash<char32_t, std::char_traits<char32_t> >( v, seed );
+}
+#endif
+
+namespace detail {
+
+// view of a view, a string or a C-string, for traits that hash by value:
+
+template< class CharT, class Traits >
+inline nssv_constexpr typename std::enable_if< hashes_by_value<Traits>::value, basic_string_view<CharT, Traits> >::type
+as_view( basic_string_view<CharT, Traits> v ) nssv_noexcept
+{
+    return v;
+}
+
+template< class CharT, class Traits, class Allocator >
+inline typename std::enable_if< hashes_by_value<Traits>::value, basic_string_view<CharT, Traits> >::type
+as_view( std::basic_string<CharT, Traits, Allocator> const & s ) nssv_noexcept
+{
+    return basic_string_view<CharT, Traits>( s.data(), s.size() );
+}
+
+template< class CharT >
+inline nssv_constexpr basic_string_view<CharT> as_view( CharT const * s ) nssv_noexcept
+{
+    return basic_string_view<CharT>( s );
+}
+
+// view of a key of another type that converts to a view of CharT with
+// Traits, such as a user type; CharT and Traits are given explicitly:
+
+template< class CharT, class Traits, class K >
+inline nssv_constexpr typename std::enable_if<
+    hashes_by_value<Traits>::value
+    && std::is_convertible< K const &, basic_string_view<CharT, Traits> >::value
+    && ! std::is_same< K, basic_string_view<CharT, Traits> >::value, basic_string_view<CharT, Traits> >::type
+as_view( K const & key )
+{
+    return key;
+}
+
+} // namespace detail
+
+// transparent hash and equality of views, strings and C-strings, for
+// heterogeneous lookup; equal keys hash alike whatever their type. Keys
+// with traits other than std::char_traits require hashes_by_value<Traits>:
+
+class sv_hasher
+{
+public:
+    typedef void is_transparent;
+
+    nssv_constexpr sv_hasher() nssv_noexcept
+        : seed_( 0 )
+    {}
+
+    nssv_constexpr explicit sv_hasher( std::uint64_t seed ) nssv_noexcept
+        : seed_( seed )
+    {}
+
+    template< class T >
+    nssv_constexpr14 std::size_t operator()( T const & key ) const nssv_noexcept
+    {
+        return static_cast<std::size_t>( sv_hash( detail::as_view( key ), seed_ ) );
+    }
+
+private:
+    std::uint64_t seed_;
+};
+
+struct sv_equal
+{
+    typedef void is_transparent;
+
+    template< class T, class U >
+    nssv_constexpr14 bool operator()( T const & lhs, U const & rhs ) const nssv_noexcept
+    {
+        return detail::as_view( lhs ) == detail::as_view( rhs );
+    }
+};
+
+//
+// Perfect-hash keyword sets and maps (extension, C++11):
+//
+// A keyword set maps each keyword of a fixed list to its position in the
+// list, and any other view to npos, without collisions. The seeded
+// sv_hash() of a key selects one of about n/2 buckets and the bucket's
+// displacement selects one of at least 2n slots; construction searches
+// the displacements, largest buckets first, such that no two keywords
+// share a slot, and tries the next seed if a bucket gets stuck. A lookup
+// hashes the key once, reads a displacement and a slot from flat arrays
+// and confirms the keyword in that slot with a single comparison.
+//
+// basic_fixed_keyword_set keeps N keywords in arrays of its own and can
+// be built at compile time in C++14, see make_keyword_set(). The runtime
+// basic_keyword_set takes a list of any length. Both refer to the
+// characters of their keywords, which must outlive them. Of duplicate
+// keywords, the first one counts. The keyword maps add a value per
+// keyword.
+
+namespace detail {
+
+typedef std::uint32_t keyword_index;
+
+nssv_constexpr keyword_index keyword_none  = 0xffffffffu;
+nssv_constexpr keyword_index keyword_tries = 0x10000u;
+
+// number of buckets, and of slots (a power of two) for n keywords:
+
+nssv_constexpr std::size_t keyword_buckets( std::size_t n ) nssv_noexcept
+{
+    return n / 2 + 1;
+}
+
+nssv_constexpr std::size_t keyword_slots( std::size_t n, std::size_t m = 2 ) nssv_noexcept
+{
+    return m >= 2 * n ? m : keyword_slots( n, 2 * m );
+}
+
+inline nssv_constexpr14 std::size_t keyword_bucket( hash_word h, std::size_t buckets ) nssv_noexcept
+{
+    return static_cast<std::size_t>( ( ( h >> 32 ) * buckets ) >> 32 );
+}
+
+inline nssv_constexpr14 std::size_t keyword_slot( hash_word h, keyword_index d, std::size_t slots ) nssv_noexcept
+{
+    return static_cast<std::size_t>( hash_mix( h, hash_p2 ^ d ) ) & ( slots - 1 );
+}
+
+// array that can be filled in a constexpr constructor:
+
+template< class T, std::size_t N >
+struct keyword_array
+{
+    T v[N];
+
+    nssv_constexpr14 T & operator[]( std::size_t i ) nssv_noexcept
+    {
+        return v[i];
+    }
+
+    nssv_constexpr T const & operator[]( std::size_t i ) const nssv_noexcept
+    {
+        return v[i];
+    }
+};
+
+// place n keywords with hashes seeded by seed; false if a bucket finds
+// no displacement. Uses hash[n], order[n] and start[buckets + 1] as
+// scratch: order lists the keywords by bucket, duplicates as none:
+
+template< class Keys, class Disp, class Slot, class Hash, class Order, class Start >
+nssv_constexpr14 bool keyword_place(
+    hash_word seed, Keys const & keys, std::size_t n,
+    Disp & disp, std::size_t buckets, Slot & slot, std::size_t slots,
+    Hash & hash, Order & order, Start & start )
+{
+    for ( std::size_t b = 0; b <= buckets; ++b )
+    {
+        start[b] = 0;
+    }
+
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        hash[i] = sv_hash( keys[i], seed );
+        ++start[ keyword_bucket( hash[i], buckets ) ];
+    }
+
+    for ( std::size_t b = 1; b <= buckets; ++b )
+    {
+        start[b] += start[b - 1];
+    }
+
+    for ( std::size_t i = n; i-- != 0; )
+    {
+        order[ --start[ keyword_bucket( hash[i], buckets ) ] ] = static_cast<keyword_index>( i );
+    }
+
+    std::size_t largest = 0;
+
+    for ( std::size_t b = 0; b != buckets; ++b )
+    {
+        disp[b] = 0;
+
+        if ( largest < start[b + 1] - start[b] )
+            largest = start[b + 1] - start[b];
+
+        for ( std::size_t j = start[b]; j != start[b + 1]; ++j )
+        {
+            for ( std::size_t k = start[b]; k != j; ++k )
+            {
+                if ( order[k] != keyword_none && hash[ order[k] ] == hash[ order[j] ] && keys[ order[k] ] == keys[ order[j] ] )
+                {
+                    order[j] = keyword_none;
+                    break;
+                }
+            }
+        }
+    }
+
+    for ( std::size_t s = 0; s != slots; ++s )
+    {
+        slot[s] = keyword_none;
+    }
+
+    for ( std::size_t size = largest; size != 0; --size )
+    {
+        for ( std::size_t b = 0; b != buckets; ++b )
+        {
+            const std::size_t first = start[b];
+            const std::size_t last  = start[b + 1];
+
+            if ( last - first != size )
+                continue;
+
+            bool placed = false;
+
+            for ( keyword_index d = 0; d != keyword_tries && ! placed; ++d )
+            {
+                std::size_t j = first;
+
+                for ( ; j != last; ++j )
+                {
+                    if ( order[j] == keyword_none )
+                        continue;
+
+                    const std::size_t s = keyword_slot( hash[ order[j] ], d, slots );
+
+                    if ( slot[s] != keyword_none )
+                        break;
+
+                    slot[s] = order[j];
+                }
+
+                placed = j == last;
+
+                if ( placed )
+                {
+                    disp[b] = d;
+                }
+                else
+                {
+                    for ( std::size_t u = first; u != j; ++u )
+                    {
+                        if ( order[u] != keyword_none )
+                            slot[ keyword_slot( hash[ order[u] ], d, slots ) ] = keyword_none;
+                    }
+                }
+            }
+
+            if ( ! placed )
+                return false;
+        }
+    }
+    return true;
+}
+
+template< class Keys, class Disp, class Slot, class Hash, class Order, class Start >
+nssv_constexpr14 hash_word keyword_build(
+    Keys const & keys, std::size_t n,
+    Disp & disp, std::size_t buckets, Slot & slot, std::size_t slots,
+    Hash & hash, Order & order, Start & start )
+{
+    hash_word seed = 0;
+
+    while ( ! keyword_place( seed, keys, n, disp, buckets, slot, slots, hash, order, start ) )
+    {
+        ++seed;
+    }
+    return seed;
+}
+
+template< class CharT, class Traits, class Keys, class Disp, class Slot >
+nssv_constexpr14 std::size_t keyword_find(
+    basic_string_view<CharT, Traits> key, hash_word seed, Keys const & keys,
+    Disp const & disp, std::size_t buckets, Slot const & slot, std::size_t slots ) nssv_noexcept
+{
+    const hash_word h = sv_hash( key, seed );
+    const keyword_index k = slot[ keyword_slot( h, disp[ keyword_bucket( h, buckets ) ], slots ) ];
+
+    if ( k != keyword_none && keys[k] == key )
+        return k;
+
+    return basic_string_view<CharT, Traits>::npos;
+}
+
+} // namespace detail
+
+// keyword set of a runtime list:
+
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_keyword_set
+{
+    static_assert( hashes_by_value<Traits>::value, "nonstd::basic_keyword_set: Traits must compare characters by value, see nonstd::hashes_by_value" );
+
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+
+    basic_keyword_set()
+    {
+        build();
+    }
+
+    template< class InputIt >
+    basic_keyword_set( InputIt first, InputIt last )
+    {
+        for ( ; first != last; ++first )
+        {
+            keys_.push_back( view_type( *first ) );
+        }
+        build();
+    }
+
+#if nssv_HAVE_INITIALIZER_LIST
+    basic_keyword_set( std::initializer_list<view_type> keys )
+        : keys_( keys.begin(), keys.end() )
+    {
+        build();
+    }
+#endif
+
+    // number of keywords, and keyword number i:
+
+    size_type size() const nssv_noexcept
+    {
+        return keys_.size();
+    }
+
+    view_type operator[]( size_type i ) const
+    {
+        return keys_[i];
+    }
+
+    // position of key in the list, or npos:
+
+    size_type find( view_type key ) const nssv_noexcept
+    {
+        return detail::keyword_find( key, seed_, keys_, disp_, disp_.size(), slot_, slot_.size() );
+    }
+
+    bool contains( view_type key ) const nssv_noexcept
+    {
+        return find( key ) != view_type::npos;
+    }
+
+private:
+    void build()
+    {
+        const size_type n = keys_.size();
+
+#if nssv_CONFIG_NO_EXCEPTIONS
+        assert( n < detail::keyword_none );
+#else
+        if ( n >= detail::keyword_none )
+        {
+            throw std::length_error("nonstd::keyword_set: too many keywords");
+        }
+#endif
+        disp_.resize( detail::keyword_buckets( n ) );
+        slot_.resize( detail::keyword_slots( n ) );
+
+        std::vector<detail::hash_word> hash( n );
+        std::vector<detail::keyword_index> order( n );
+        std::vector<detail::keyword_index> start( disp_.size() + 1 );
+
+        seed_ = detail::keyword_build( keys_, n, disp_, disp_.size(), slot_, slot_.size(), hash, order, start );
+    }
+
+    std::vector<view_type> keys_;
+    std::vector<detail::keyword_index> disp_;
+    std::vector<detail::keyword_index> slot_;
+    detail::hash_word seed_;
+};
+
+// keyword set of N keywords, constexpr in C++14:
+
+template
+<
+    class CharT,
+    std::size_t N,
+    class Traits = std::char_traits<CharT>
+>
+class basic_fixed_keyword_set
+{
+    static_assert( hashes_by_value<Traits>::value, "nonstd::basic_fixed_keyword_set: Traits must compare characters by value, see nonstd::hashes_by_value" );
+
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+
+    nssv_constexpr14 explicit basic_fixed_keyword_set( view_type const (&keys)[N] )
+        : keys_(), disp_(), slot_(), seed_( 0 )
+    {
+        for ( size_type i = 0; i != N; ++i )
+        {
+            keys_[i] = keys[i];
+        }
+
+        detail::keyword_array<detail::hash_word, N> hash = {};
+        detail::keyword_array<detail::keyword_index, N> order = {};
+        detail::keyword_array<detail::keyword_index, buckets + 1> start = {};
+
+        seed_ = detail::keyword_build( keys_, N, disp_, buckets, slot_, slots, hash, order, start );
+    }
+
+    // number of keywords, and keyword number i:
+
+    nssv_constexpr size_type size() const nssv_noexcept
+    {
+        return N;
+    }
+
+    nssv_constexpr view_type operator[]( size_type i ) const
+    {
+        return keys_[i];
+    }
+
+    // position of key in the list, or npos:
+
+    nssv_constexpr14 size_type find( view_type key ) const nssv_noexcept
+    {
+        return detail::keyword_find( key, seed_, keys_, disp_, buckets, slot_, slots );
+    }
+
+    nssv_constexpr14 bool contains( view_type key ) const nssv_noexcept
+    {
+        return find( key ) != view_type::npos;
+    }
+
+private:
+    enum { buckets = detail::keyword_buckets( N ) };
+    enum { slots   = detail::keyword_slots( N )   };
+
+    detail::keyword_array<view_type, N> keys_;
+    detail::keyword_array<detail::keyword_index, buckets> disp_;
+    detail::keyword_array<detail::keyword_index, slots> slot_;
+    detail::hash_word seed_;
+};
+
+template< class CharT, class Traits, std::size_t N >
+nssv_constexpr14 basic_fixed_keyword_set<CharT, N, Traits>
+make_keyword_set( basic_string_view<CharT, Traits> const (&keys)[N] )
+{
+    return basic_fixed_keyword_set<CharT, N, Traits>( keys );
+}
+
+// keyword map of a runtime list of keyword-value pairs:
+
+template
+<
+    class CharT,
+    class T,
+    class Traits = std::char_traits<CharT>
+>
+class basic_keyword_map
+{
+    static_assert( hashes_by_value<Traits>::value, "nonstd::basic_keyword_map: Traits must compare characters by value, see nonstd::hashes_by_value" );
+
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+    typedef T                                mapped_type;
+    typedef std::pair<view_type, T>          value_type;
+
+    template< class InputIt >
+    basic_keyword_map( InputIt first, InputIt last )
+    {
+        build( first, last );
+    }
+
+#if nssv_HAVE_INITIALIZER_LIST
+    basic_keyword_map( std::initializer_list<value_type> entries )
+    {
+        build( entries.begin(), entries.end() );
+    }
+#endif
+
+    size_type size() const nssv_noexcept
+    {
+        return keys_.size();
+    }
+
+    // value of key, or null:
+
+    T const * find( view_type key ) const nssv_noexcept
+    {
+        const size_type i = keys_.find( key );
+        return i != view_type::npos ? &values_[i] : nssv_nullptr;
+    }
+
+    bool contains( view_type key ) const nssv_noexcept
+    {
+        return keys_.contains( key );
+    }
+
+private:
+    template< class InputIt >
+    void build( InputIt first, InputIt last )
+    {
+        std::vector<view_type> keys;
+
+        for ( ; first != last; ++first )
+        {
+            keys.push_back( view_type( first->first ) );
+            values_.push_back( first->second );
+        }
+        keys_ = basic_keyword_set<CharT, Traits>( keys.begin(), keys.end() );
+    }
+
+    basic_keyword_set<CharT, Traits> keys_;
+    std::vector<T> values_;
+};
+
+// keyword map of N keyword-value pairs, constexpr in C++14 for a literal
+// type T with a constexpr default constructor:
+
+template
+<
+    class CharT,
+    class T,
+    std::size_t N,
+    class Traits = std::char_traits<CharT>
+>
+class basic_fixed_keyword_map
+{
+    static_assert( hashes_by_value<Traits>::value, "nonstd::basic_fixed_keyword_map: Traits must compare characters by value, see nonstd::hashes_by_value" );
+
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef typename view_type::size_type    size_type;
+    typedef T                                mapped_type;
+    typedef std::pair<view_type, T>          value_type;
+
+    nssv_constexpr14 explicit basic_fixed_keyword_map( value_type const (&entries)[N] )
+        : keys_( keys_of( entries ).v ), values_()
+    {
+        for ( size_type i = 0; i != N; ++i )
+        {
+            values_[i] = entries[i].second;
+        }
+    }
+
+    nssv_constexpr size_type size() const nssv_noexcept
+    {
+        return N;
+    }
+
+    // value of key, or null:
+
+    nssv_constexpr14 T const * find( view_type key ) const nssv_noexcept
+    {
+        const size_type i = keys_.find( key );
+        return i != view_type::npos ? &values_[i] : nssv_nullptr;
+    }
+
+    nssv_constexpr14 bool contains( view_type key ) const nssv_noexcept
+    {
+        return keys_.contains( key );
+    }
+
+private:
+    static nssv_constexpr14 detail::keyword_array<view_type, N> keys_of( value_type const (&entries)[N] )
+    {
+        detail::keyword_array<view_type, N> keys = {};
+
+        for ( size_type i = 0; i != N; ++i )
+        {
+            keys[i] = entries[i].first;
+        }
+        return keys;
+    }
+
+    basic_fixed_keyword_set<CharT, N, Traits> keys_;
+    detail::keyword_array<T, N> values_;
+};
+
+template< class CharT, class Traits, class T, std::size_t N >
+nssv_constexpr14 basic_fixed_keyword_map<CharT, T, N, Traits>
+make_keyword_map( std::pair<basic_string_view<CharT, Traits>, T> const (&entries)[N] )
+{
+    return basic_fixed_keyword_map<CharT, T, N, Traits>( entries );
+}
+
+typedef basic_keyword_set<char>      keyword_set;
+typedef basic_keyword_set<wchar_t>   wkeyword_set;
+#if nssv_HAVE_WCHAR16_T
+typedef basic_keyword_set<char16_t>  u16keyword_set;
+#endif
+#if nssv_HAVE_WCHAR32_T
+typedef basic_keyword_set<char32_t>  u32keyword_set;
+#endif
+
+//
+// Flat hash map with string keys (extension, C++11):
+//
+// basic_string_map maps views to values as a Swiss table does. Each slot
+// has a control byte that marks it empty or deleted, or that holds 7 bits
+// of the sv_hash() of its key. The other bits of the hash select the first
+// of the groups of 16 slots to probe, quadratically. A lookup compares the
+// 16 control bytes of a group with the key's 7 bits at once via SSE2, and
+// compares the keys of the matching slots only. A probe ends at a group
+// with an empty slot. A slot holds the 32-bit index of its entry; the
+// entries are kept contiguously, as key-value pairs in a vector.
+//
+// The map copies the characters of each key into an arena of its own, so
+// that its keys remain valid whatever becomes of the inserted view, until
+// clear() or the map's destruction. Insertion may move the entries, and
+// erase() moves the last entry into the gap.
+
+namespace detail {
+
+// control bytes: empty, deleted or the 7 bits of the hash of a full slot:
+
+nssv_constexpr unsigned char map_empty   = 0x80u;
+nssv_constexpr unsigned char map_deleted = 0xfeu;
+nssv_constexpr std::size_t   map_group   = 16;
+
+// bit i set for control byte i of the group at ctrl that equals c,
+// or that is empty or deleted:
+
+inline unsigned map_match( unsigned char const * ctrl, unsigned char c ) nssv_noexcept
+{
+#if nssv_HAVE_SSE2
+    return movemask( _mm_cmpeq_epi8( load128( ctrl ), _mm_set1_epi8( static_cast<char>( c ) ) ) );
+#else
+    unsigned m = 0;
+
+    for ( unsigned i = 0; i != map_group; ++i )
+    {
+        m |= static_cast<unsigned>( ctrl[i] == c ) << i;
+    }
+    return m;
+#endif
+}
+
+inline unsigned map_match_free( unsigned char const * ctrl ) nssv_noexcept
+{
+#if nssv_HAVE_SSE2
+    return movemask( load128( ctrl ) );
+#else
+    unsigned m = 0;
+
+    for ( unsigned i = 0; i != map_group; ++i )
+    {
+        m |= static_cast<unsigned>( ctrl[i] >> 7 ) << i;
+    }
+    return m;
+#endif
+}
+
+// copies of character sequences, in blocks that never move; a sequence
+// of at least half a block gets a block of its own:
+
+template< class CharT >
+class string_arena
+{
+public:
+    string_arena() nssv_noexcept
+        : next_( nssv_nullptr ), left_( 0 )
+    {}
+
+    CharT const * copy( CharT const * s, std::size_t n )
+    {
+        if ( n == 0 )
+            return nssv_nullptr;
+
+        if ( n >= block / 2 )
+        {
+            blocks_.push_back( std::vector<CharT>( s, s + n ) );
+            return blocks_.back().data();
+        }
+
+        if ( n > left_ )
+        {
+            blocks_.push_back( std::vector<CharT>( block ) );
+            next_ = blocks_.back().data();
+            left_ = block;
+        }
+
+        CharT * p = next_;
+        std::copy( s, s + n, p );
+        next_ += n;
+        left_ -= n;
+        return p;
+    }
+
+    void clear() nssv_noexcept
+    {
+        blocks_.clear();
+        next_ = nssv_nullptr;
+        left_ = 0;
+    }
+
+    void swap( string_arena & other ) nssv_noexcept
+    {
+        blocks_.swap( other.blocks_ );
+        std::swap( next_, other.next_ );
+        std::swap( left_, other.left_ );
+    }
+
+private:
+    enum { block = 4096 / sizeof(CharT) };
+
+    std::vector< std::vector<CharT> > blocks_;
+    CharT * next_;
+    std::size_t left_;
+};
+
+} // namespace detail
+
+template
+<
+    class CharT,
+    class T,
+    class Traits = std::char_traits<CharT>
+>
+class basic_string_map
+{
+public:
+    typedef basic_string_view<CharT, Traits>  key_type;
+    typedef T                                 mapped_type;
+    typedef std::pair<key_type, T>            value_type;
+    typedef std::size_t                       size_type;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    basic_string_map() nssv_noexcept
+        : seed_( 0 ), growth_left_( 0 )
+    {}
+
+    explicit basic_string_map( std::uint64_t seed ) nssv_noexcept
+        : seed_( seed ), growth_left_( 0 )
+    {}
+
+    basic_string_map( basic_string_map const & other )
+        : seed_( other.seed_ ), growth_left_( 0 )
+    {
+        reserve( other.size() );
+
+        for ( const_iterator it = other.begin(); it != other.end(); ++it )
+        {
+            emplace( it->first, it->second );
+        }
+    }
+
+    basic_string_map( basic_string_map && other ) nssv_noexcept
+        : seed_( other.seed_ ), growth_left_( 0 )
+    {
+        swap( other );
+    }
+
+    basic_string_map & operator=( basic_string_map other ) nssv_noexcept
+    {
+        swap( other );
+        return *this;
+    }
+
+    void swap( basic_string_map & other ) nssv_noexcept
+    {
+        ctrl_.swap( other.ctrl_ );
+        slot_.swap( other.slot_ );
+        entries_.swap( other.entries_ );
+        arena_.swap( other.arena_ );
+        std::swap( seed_, other.seed_ );
+        std::swap( growth_left_, other.growth_left_ );
+    }
+
+    // entries, in the order of insertion, unless erased:
+
+    const_iterator begin() const nssv_noexcept
+    {
+        return entries_.begin();
+    }
+
+    const_iterator end() const nssv_noexcept
+    {
+        return entries_.end();
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator==(
-    std::basic_string<CharT, Traits> rhs,
-    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
-{ return lhs.size() == rhs.size() && lhs.compare( rhs ) == 0; }
+    size_type size() const nssv_noexcept
+    {
+        return entries_.size();
+    }
 
-// !=
+    bool empty() const nssv_noexcept
+    {
+        return entries_.empty();
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator!=(
-    basic_string_view<CharT, Traits> lhs,
-    CharT const * rhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+    // make room for n entries without rehashing:
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator!=(
-    CharT const * lhs,
-    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+    void reserve( size_type n )
+    {
+        entries_.reserve( n );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator!=(
-    basic_string_view<CharT, Traits> lhs,
-    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+        if ( n > size() + growth_left_ )
+        {
+            rehash( n );
+        }
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator!=(
-    std::basic_string<CharT, Traits> rhs,
-    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+    void clear() nssv_noexcept
+    {
+        entries_.clear();
+        arena_.clear();
+        std::fill( ctrl_.begin(), ctrl_.end(), detail::map_empty );
+        growth_left_ = max_load( ctrl_.size() );
+    }
 
-// <
+    // value of a key that is a view, a string or a C-string, or null:
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<(
-    basic_string_view<CharT, Traits> lhs,
-    CharT const * rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) < 0; }
+    template< class K >
+    T * find( K const & key ) nssv_noexcept
+    {
+        const key_type k = view_of( key );
+        const size_type s = locate( k, sv_hash( k, seed_ ) );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<(
-    CharT const * lhs,
-    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
-{ return rhs.compare( lhs ) > 0; }
+        return s != detail::npos ? &entries_[ slot_[s] ].second : nssv_nullptr;
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<(
-    basic_string_view<CharT, Traits> lhs,
-    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) < 0; }
+    template< class K >
+    T const * find( K const & key ) const nssv_noexcept
+    {
+        const key_type k = view_of( key );
+        const size_type s = locate( k, sv_hash( k, seed_ ) );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<(
-    std::basic_string<CharT, Traits> rhs,
-    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
-{ return rhs.compare( lhs ) > 0; }
+        return s != detail::npos ? &entries_[ slot_[s] ].second : nssv_nullptr;
+    }
 
-// <=
+    template< class K >
+    bool contains( K const & key ) const nssv_noexcept
+    {
+        return find( key ) != nssv_nullptr;
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<=(
-    basic_string_view<CharT, Traits> lhs,
-    CharT const * rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) <= 0; }
+    // insert a copy of key with a value constructed from args, unless
+    // key is present; the value of key, and whether it was inserted:
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<=(
-    CharT const * lhs,
-    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
-{ return rhs.compare( lhs ) >= 0; }
+    template< class K, class... Args >
+    std::pair<T *, bool> emplace( K const & key, Args &&... args )
+    {
+        const key_type k = view_of( key );
+        const detail::hash_word h = sv_hash( k, seed_ );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<=(
-    basic_string_view<CharT, Traits> lhs,
-    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) <= 0; }
+        size_type s = locate( k, h );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator<=(
-    std::basic_string<CharT, Traits> rhs,
-    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
-{ return rhs.compare( lhs ) >= 0; }
+        if ( s != detail::npos )
+        {
+            return std::pair<T *, bool>( &entries_[ slot_[s] ].second, false );
+        }
 
-// >
+#if nssv_CONFIG_NO_EXCEPTIONS
+        assert( size() < 0xffffffffu );
+#else
+        if ( size() >= 0xffffffffu )
+        {
+            throw std::length_error("nonstd::string_map: too many entries");
+        }
+#endif
+        if ( ctrl_.empty() )
+        {
+            rehash( 1 );
+        }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>(
-    basic_string_view<CharT, Traits> lhs,
-    CharT const * rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) > 0; }
+        s = free_slot( h );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>(
-    CharT const * lhs,
-    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
-{ return rhs.compare( lhs ) < 0; }
+        if ( growth_left_ == 0 && ctrl_[s] != detail::map_deleted )
+        {
+            rehash( 2 * ( size() + 1 ) );
+            s = free_slot( h );
+        }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>(
-    basic_string_view<CharT, Traits> lhs,
-    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) > 0; }
+        entries_.push_back( value_type( store( k ), T( std::forward<Args>( args )... ) ) );
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>(
-    std::basic_string<CharT, Traits> rhs,
-    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
-{ return rhs.compare( lhs ) < 0; }
+        growth_left_ -= ctrl_[s] == detail::map_empty;
+        ctrl_[s] = static_cast<unsigned char>( h & 0x7fu );
+        slot_[s] = static_cast<std::uint32_t>( size() - 1 );
 
-// >=
+        return std::pair<T *, bool>( &entries_.back().second, true );
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>=(
-    basic_string_view<CharT, Traits> lhs,
-    CharT const * rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) >= 0; }
+    template< class K >
+    std::pair<T *, bool> insert( K const & key, T const & value )
+    {
+        return emplace( key, value );
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>=(
-    CharT const * lhs,
-    basic_string_view<CharT, Traits> rhs ) nssv_noexcept
-{ return rhs.compare( lhs ) <= 0; }
+    template< class K >
+    T & operator[]( K const & key )
+    {
+        return *emplace( key ).first;
+    }
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>=(
-    basic_string_view<CharT, Traits> lhs,
-    std::basic_string<CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) >= 0; }
+    // erase the entry of key; whether it was present:
 
-template< class CharT, class Traits>
-nssv_constexpr bool operator>=(
-    std::basic_string<CharT, Traits> rhs,
-    basic_string_view<CharT, Traits> lhs ) nssv_noexcept
-{ return rhs.compare( lhs ) <= 0; }
+    template< class K >
+    bool erase( K const & key )
+    {
+        const key_type k = view_of( key );
+        const size_type s = locate( k, sv_hash( k, seed_ ) );
+
+        if ( s == detail::npos )
+            return false;
+
+        const std::uint32_t i = slot_[s];
+
+        if ( i + 1u != size() )
+        {
+            slot_[ locate( entries_.back().first, sv_hash( entries_.back().first, seed_ ) ) ] = i;
+            entries_[i] = std::move( entries_.back() );
+        }
+        entries_.pop_back();
+
+        // a group with an empty slot ends every probe that reaches it,
+        // so its slot can become empty again, otherwise it stays deleted:
+
+        if ( detail::map_match( &ctrl_[ s - s % detail::map_group ], detail::map_empty ) != 0 )
+        {
+            ctrl_[s] = detail::map_empty;
+            ++growth_left_;
+        }
+        else
+        {
+            ctrl_[s] = detail::map_deleted;
+        }
+        return true;
+    }
+
+private:
+    // entries of a table with capacity slots, at 7/8 load:
+
+    static size_type max_load( size_type capacity ) nssv_noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    template< class K >
+    static key_type view_of( K const & key )
+    {
+        return detail::as_view<CharT, Traits>( key );
+    }
+
+    key_type store( key_type k )
+    {
+        return key_type( arena_.copy( k.data(), k.size() ), k.size() );
+    }
+
+    // slot of key with hash h, or npos:
+
+    size_type locate( key_type key, detail::hash_word h ) const nssv_noexcept
+    {
+        if ( ctrl_.empty() )
+            return detail::npos;
+
+        const size_type mask = ctrl_.size() / detail::map_group - 1;
+        const unsigned char h7 = static_cast<unsigned char>( h & 0x7fu );
+
+        for ( size_type g = static_cast<size_type>( h >> 7 ) & mask, step = 1; ; g = ( g + step++ ) & mask )
+        {
+            unsigned char const * ctrl = &ctrl_[ g * detail::map_group ];
+
+            for ( unsigned m = detail::map_match( ctrl, h7 ); m != 0; m &= m - 1 )
+            {
+                const size_type s = g * detail::map_group + detail::ctz( m );
+
+                if ( entries_[ slot_[s] ].first == key )
+                    return s;
+            }
+
+            if ( detail::map_match( ctrl, detail::map_empty ) != 0 )
+                return detail::npos;
+        }
+    }
+
+    // first empty or deleted slot on the probe of hash h:
+
+    size_type free_slot( detail::hash_word h ) const nssv_noexcept
+    {
+        const size_type mask = ctrl_.size() / detail::map_group - 1;
+
+        for ( size_type g = static_cast<size_type>( h >> 7 ) & mask, step = 1; ; g = ( g + step++ ) & mask )
+        {
+            const unsigned m = detail::map_match_free( &ctrl_[ g * detail::map_group ] );
+
+            if ( m != 0 )
+                return g * detail::map_group + detail::ctz( m );
+        }
+    }
+
+    // rebuild the table for n entries, dropping deleted slots:
+
+    void rehash( size_type n )
+    {
+        size_type capacity = detail::map_group;
+
+        while ( max_load( capacity ) < n )
+        {
+            capacity *= 2;
+        }
+
+        ctrl_.assign( capacity, detail::map_empty );
+        slot_.assign( capacity, 0 );
+
+        for ( size_type i = 0; i != size(); ++i )
+        {
+            const detail::hash_word h = sv_hash( entries_[i].first, seed_ );
+            const size_type s = free_slot( h );
+
+            ctrl_[s] = static_cast<unsigned char>( h & 0x7fu );
+            slot_[s] = static_cast<std::uint32_t>( i );
+        }
+        growth_left_ = max_load( capacity ) - size();
+    }
+
+    std::vector<unsigned char> ctrl_;
+    std::vector<std::uint32_t> slot_;
+    std::vector<value_type> entries_;
+    detail::string_arena<CharT> arena_;
+    std::uint64_t seed_;
+    size_type growth_left_;
+};
+
+#if nssv_CONFIG_STRING_POOL
+
+//
+// Concurrent string interning pool (extension, C++11, opt-in via
+// nssv_CONFIG_STRING_POOL, as it requires <atomic>, <mutex> and threads):
+//
+// basic_string_pool keeps a single copy of each distinct string interned
+// and numbers the strings densely from 0, in the order they are added.
+// Equal strings yield the same view and id, so that interned views can be
+// compared via their data() pointer.
+//
+// The high bits of the sv_hash() of a string select one of 64 shards. A
+// shard is an insert-only open-addressing table of 64-bit atomic slots,
+// each holding 32 bits of the hash of a string and its id, next to the
+// string's view. Lookups probe it linearly without a lock, so an interned
+// string is found without a write to shared memory. Adding a string takes
+// the shard's mutex: the thread copies the characters into the shard's
+// arena, records the view with the slot and under the new id, and only
+// then publishes the slot. A table at half load
+// is replaced by one twice its size; the old table is kept for readers
+// that may still probe it, until the pool's destruction.
+
+namespace detail {
+
+nssv_constexpr std::uint32_t pool_none = 0xffffffffu;
+
+// cells of a shard, a power of two of them; a cell's slot is 0 if it is
+// empty, otherwise the high half of the hash of a string and 1 + its id,
+// and its view, recorded before the slot, refers to the string:
+
+template< class View >
+struct pool_cell
+{
+    pool_cell() nssv_noexcept
+        : slot( 0 )
+    {}
+
+    std::atomic<std::uint64_t> slot;
+    View view;
+};
+
+template< class View >
+struct pool_table
+{
+    explicit pool_table( std::size_t n )
+        : mask( n - 1 ), cells( n )
+    {}
+
+    std::size_t mask;
+    std::vector< pool_cell<View> > cells;
+};
+
+} // namespace detail
+
+template
+<
+    class CharT,
+    class Traits = std::char_traits<CharT>
+>
+class basic_string_pool
+{
+    static_assert( hashes_by_value<Traits>::value, "nonstd::basic_string_pool: Traits must compare characters by value, see nonstd::hashes_by_value" );
+
+public:
+    typedef basic_string_view<CharT, Traits> view_type;
+    typedef std::size_t                      size_type;
+
+    // an interned string and its number:
+
+    struct entry
+    {
+        view_type     view;
+        std::uint32_t id;
+    };
+
+    basic_string_pool()
+        : seed_( 0 ), size_( 0 )
+    {
+        init();
+    }
+
+    explicit basic_string_pool( std::uint64_t seed )
+        : seed_( seed ), size_( 0 )
+    {
+        init();
+    }
+
+    basic_string_pool( basic_string_pool const & ) = delete;
+    basic_string_pool & operator=( basic_string_pool const & ) = delete;
+
+    ~basic_string_pool()
+    {
+        for ( std::size_t i = 0; i != shards; ++i )
+        {
+            for ( std::size_t k = 0; k != shards_[i].tables.size(); ++k )
+            {
+                delete shards_[i].tables[k];
+            }
+        }
+
+        for ( std::size_t k = 0; k != segments; ++k )
+        {
+            delete[] segments_[k].load( std::memory_order_relaxed );
+        }
+    }
+
+    // the interned copy of s and its id, adding s if it is new; safe to
+    // call concurrently:
+
+    entry intern( view_type s )
+    {
+        const detail::hash_word h = sv_hash( s, seed_ );
+        shard & sh = shards_[ h >> 58 ];
+
+        const entry e = lookup( sh.table.load( std::memory_order_acquire ), h, s );
+
+        if ( e.id == detail::pool_none )
+        {
+            std::lock_guard<std::mutex> lock( sh.mutex );
+            return add( sh, h, s );
+        }
+        return e;
+    }
 
-#else // newer compilers:
+    // the interned string with number id, an id obtained from intern()
+    // by this thread, or by another thread that synchronized with it:
 
-#define nssv_BASIC_STRING_VIEW_I(T,U)  typename std::decay< basic_string_view<T,U> >::type
+    view_type view( std::uint32_t id ) const nssv_noexcept
+    {
+        const unsigned k = detail::bsr( id / segment + 1 );
 
-#if defined(_MSC_VER)       // issue 40
-# define nssv_MSVC_ORDER(x)  , int=x
-#else
-# define nssv_MSVC_ORDER(x)  /*, int=x*/
-#endif
+        return segments_[k].load( std::memory_order_acquire )[ id - segment * ( ( std::size_t( 1 ) << k ) - 1 ) ];
+    }
 
-// ==
+    // number of ids handed out; this includes the ids of strings that other
+    // threads are still adding, whose views may not yet be recorded, so an
+    // id below size() is not necessarily valid for view():
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
-nssv_constexpr bool operator==(
-         basic_string_view  <CharT, Traits> lhs,
-    nssv_BASIC_STRING_VIEW_I(CharT, Traits) rhs ) nssv_noexcept
-{ return lhs.size() == rhs.size() && lhs.compare( rhs ) == 0; }
+    size_type size() const nssv_noexcept
+    {
+        return size_.load( std::memory_order_acquire );
+    }
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
-nssv_constexpr bool operator==(
-    nssv_BASIC_STRING_VIEW_I(CharT, Traits) lhs,
-         basic_string_view  <CharT, Traits> rhs ) nssv_noexcept
-{ return lhs.size() == rhs.size() && lhs.compare( rhs ) == 0; }
+private:
+    // ids are recorded in segments of 1024, 2048, 4096, ... views:
 
-// !=
+    enum { shards = 64, segments = 32, segment = 1024 };
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
-nssv_constexpr bool operator!= (
-         basic_string_view  < CharT, Traits > lhs,
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+    typedef detail::pool_table<view_type> table_type;
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
-nssv_constexpr bool operator!= (
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
-         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
-{ return !( lhs == rhs ); }
+    struct alignas(64) shard    // keep shards apart in the cache
+    {
+        shard()
+            : table( nssv_nullptr ), count( 0 )
+        {}
+
+        std::mutex mutex;
+        std::atomic<table_type *> table;
+        std::size_t count;
+        std::vector<table_type *> tables;
+        detail::string_arena<CharT> arena;
+    };
 
-// <
+    void init() nssv_noexcept
+    {
+        for ( std::size_t k = 0; k != segments; ++k )
+        {
+            segments_[k].store( nssv_nullptr, std::memory_order_relaxed );
+        }
+    }
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
-nssv_constexpr bool operator< (
-         basic_string_view  < CharT, Traits > lhs,
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) < 0; }
+    // the entry of s, or an entry with id none:
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
-nssv_constexpr bool operator< (
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
-         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) < 0; }
+    static entry lookup( table_type const * t, detail::hash_word h, view_type s ) nssv_noexcept
+    {
+        for ( std::size_t i = static_cast<std::size_t>( h ); t != nssv_nullptr; ++i )
+        {
+            detail::pool_cell<view_type> const & c = t->cells[ i & t->mask ];
 
-// <=
+            const std::uint64_t v = c.slot.load( std::memory_order_acquire );
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
-nssv_constexpr bool operator<= (
-         basic_string_view  < CharT, Traits > lhs,
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) <= 0; }
+            if ( v == 0 )
+                break;
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
-nssv_constexpr bool operator<= (
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
-         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) <= 0; }
+            if ( ( v >> 32 ) == ( h >> 32 ) && c.view == s )
+            {
+                const entry e = { c.view, static_cast<std::uint32_t>( v ) - 1 };
+                return e;
+            }
+        }
 
-// >
+        const entry none = { view_type(), detail::pool_none };
+        return none;
+    }
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
-nssv_constexpr bool operator> (
-         basic_string_view  < CharT, Traits > lhs,
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) > 0; }
+    static void place( table_type & t, detail::hash_word h, std::uint64_t v, view_type s ) nssv_noexcept
+    {
+        std::size_t i = static_cast<std::size_t>( h ) & t.mask;
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
-nssv_constexpr bool operator> (
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
-         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) > 0; }
+        while ( t.cells[i].slot.load( std::memory_order_relaxed ) != 0 )
+        {
+            i = ( i + 1 ) & t.mask;
+        }
+        t.cells[i].view = s;
+        t.cells[i].slot.store( v, std::memory_order_release );
+    }
 
-// >=
+    // add s to a shard whose mutex this thread holds:
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(1) >
-nssv_constexpr bool operator>= (
-         basic_string_view  < CharT, Traits > lhs,
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) >= 0; }
+    entry add( shard & sh, detail::hash_word h, view_type s )
+    {
+        table_type * t = sh.table.load( std::memory_order_relaxed );
 
-template< class CharT, class Traits  nssv_MSVC_ORDER(2) >
-nssv_constexpr bool operator>= (
-    nssv_BASIC_STRING_VIEW_I( CharT, Traits ) lhs,
-         basic_string_view  < CharT, Traits > rhs ) nssv_noexcept
-{ return lhs.compare( rhs ) >= 0; }
+        const entry found = lookup( t, h, s );
 
-#undef nssv_MSVC_ORDER
-#undef nssv_BASIC_STRING_VIEW_I
+        if ( found.id != detail::pool_none )
+            return found;
 
-#endif // compiler-dependent approach to comparisons
+        if ( t == nssv_nullptr || 2 * ( sh.count + 1 ) > t->cells.size() )
+        {
+            t = grow( sh, t );
+        }
 
-// 24.4.4 Inserters and extractors:
+        const entry e = { view_type( sh.arena.copy( s.data(), s.size() ), s.size() ), next_id() };
 
-#if ! nssv_CONFIG_NO_STREAM_INSERTION
+        record( e.id ) = e.view;
+        place( *t, h, ( h >> 32 << 32 ) | ( e.id + 1u ), e.view );
+        ++sh.count;
 
-namespace detail {
+        return e;
+    }
 
-template< class Stream >
-void write_padding( Stream & os, std::streamsize n )
-{
-    for ( std::streamsize i = 0; i < n; ++i )
-        os.rdbuf()->sputc( os.fill() );
-}
+    table_type * grow( shard & sh, table_type * t )
+    {
+        sh.tables.reserve( sh.tables.size() + 1 );
+        sh.tables.push_back( new table_type( t != nssv_nullptr ? 2 * t->cells.size() : 16 ) );
 
-template< class Stream, class View >
-Stream & write_to_stream( Stream & os, View const & sv )
-{
-    typename Stream::sentry sentry( os );
+        table_type * bigger = sh.tables.back();
 
-    if ( !sentry )
-        return os;
+        for ( std::size_t i = 0; t != nssv_nullptr && i != t->cells.size(); ++i )
+        {
+            const std::uint64_t v = t->cells[i].slot.load( std::memory_order_relaxed );
 
-    const std::streamsize length = static_cast<std::streamsize>( sv.length() );
+            if ( v != 0 )
+                place( *bigger, sv_hash( t->cells[i].view, seed_ ), v, t->cells[i].view );
+        }
 
-    // Whether, and how, to pad:
-    const bool      pad = ( length < os.width() );
-    const bool left_pad = pad && ( os.flags() & std::ios_base::adjustfield ) == std::ios_base::right;
+        sh.table.store( bigger, std::memory_order_release );
+        return bigger;
+    }
 
-    if ( left_pad )
-        write_padding( os, os.width() - length );
+    std::uint32_t next_id()
+    {
+        std::uint32_t id = size_.load( std::memory_order_relaxed );
 
-    // Write span characters:
-    os.rdbuf()->sputn( sv.begin(), length );
+        do
+        {
+#if nssv_CONFIG_NO_EXCEPTIONS
+            assert( id != detail::pool_none );
+#else
+            if ( id == detail::pool_none )
+            {
+                throw std::length_error("nonstd::string_pool: too many strings");
+            }
+#endif
+        }
+        while ( ! size_.compare_exchange_weak( id, id + 1, std::memory_order_acq_rel ) );
 
-    if ( pad && !left_pad )
-        write_padding( os, os.width() - length );
+        return id;
+    }
 
-    // Reset output stream width:
-    os.width( 0 );
+    // the view of id, allocating its segment if it is the first:
 
-    return os;
-}
+    view_type & record( std::uint32_t id )
+    {
+        const unsigned k = detail::bsr( id / segment + 1 );
 
-} // namespace detail
+        view_type * p = segments_[k].load( std::memory_order_acquire );
 
-template< class CharT, class Traits >
-std::basic_ostream<CharT, Traits> &
-operator<<(
-    std::basic_ostream<CharT, Traits>& os,
-    basic_string_view <CharT, Traits> sv )
-{
-    return detail::write_to_stream( os, sv );
-}
+        if ( p == nssv_nullptr )
+        {
+            view_type * q = new view_type[ std::size_t( segment ) << k ];
 
-#endif // nssv_CONFIG_NO_STREAM_INSERTION
+            if ( segments_[k].compare_exchange_strong( p, q, std::memory_order_acq_rel ) )
+                p = q;
+            else
+                delete[] q;
+        }
+        return p[ id - segment * ( ( std::size_t( 1 ) << k ) - 1 ) ];
+    }
 
-// Several typedefs for common character types are provided:
+    shard shards_[shards];
+    std::atomic<view_type *> segments_[segments];
+    std::uint64_t seed_;
+    alignas(64) std::atomic<std::uint32_t> size_;
+};
 
-typedef basic_string_view<char>      string_view;
-typedef basic_string_view<wchar_t>   wstring_view;
+typedef basic_string_pool<char>      string_pool;
+typedef basic_string_pool<wchar_t>   wstring_pool;
 #if nssv_HAVE_WCHAR16_T
-typedef basic_string_view<char16_t>  u16string_view;
-typedef basic_string_view<char32_t>  u32string_view;
+typedef basic_string_pool<char16_t>  u16string_pool;
+#endif
+#if nssv_HAVE_WCHAR32_T
+typedef basic_string_pool<char32_t>  u32string_pool;
 #endif
 
+#endif // nssv_CONFIG_STRING_POOL
+
+#endif // nssv_CPP11_OR_GREATER
+
 }} // namespace nonstd::sv_lite
 
 //
@@ -1556,6 +6715,32 @@ nssv_constexpr nonstd::sv_lite::wstring_view operator""_sv( const wchar_t* str,
     return nonstd::sv_lite::wstring_view{ str, len };
 }
 
+// sv_hash() of the literal, to switch on the hash of a view (extension, C++14):
+
+#if nssv_HAVE_CONSTEXPR_14
+
+constexpr std::uint64_t operator""_svh( const char* str, size_t len ) noexcept  // (1)
+{
+    return nonstd::sv_lite::sv_hash( nonstd::sv_lite::string_view{ str, len } );
+}
+
+constexpr std::uint64_t operator""_svh( const char16_t* str, size_t len ) noexcept  // (2)
+{
+    return nonstd::sv_lite::sv_hash( nonstd::sv_lite::u16string_view{ str, len } );
+}
+
+constexpr std::uint64_t operator""_svh( const char32_t* str, size_t len ) noexcept  // (3)
+{
+    return nonstd::sv_lite::sv_hash( nonstd::sv_lite::u32string_view{ str, len } );
+}
+
+constexpr std::uint64_t operator""_svh( const wchar_t* str, size_t len ) noexcept  // (4)
+{
+    return nonstd::sv_lite::sv_hash( nonstd::sv_lite::wstring_view{ str, len } );
+}
+
+#endif // nssv_HAVE_CONSTEXPR_14
+
 #endif // nssv_CONFIG_USR_SV_OPERATOR
 
 }}} // namespace nonstd::literals::string_view_literals
@@ -1628,14 +6813,109 @@ using sv_lite::u16string_view;
 using sv_lite::u32string_view;
 #endif
 
+using sv_lite::basic_searcher;
+using sv_lite::searcher;
+using sv_lite::wsearcher;
+
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16searcher;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32searcher;
+#endif
+
+using sv_lite::basic_char_set;
+using sv_lite::char_set;
+using sv_lite::wchar_set;
+
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16char_set;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32char_set;
+#endif
+
+using sv_lite::basic_multi_searcher;
+using sv_lite::multi_searcher;
+using sv_lite::wmulti_searcher;
+
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16multi_searcher;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32multi_searcher;
+#endif
+
+using sv_lite::basic_packed_searcher;
+using sv_lite::packed_searcher;
+using sv_lite::wpacked_searcher;
+
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16packed_searcher;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32packed_searcher;
+#endif
+
+using sv_lite::find_mode;
+using sv_lite::find_overlapping;
+using sv_lite::find_non_overlapping;
+using sv_lite::find_all;
+using sv_lite::basic_match_range;
+using sv_lite::match_range;
+using sv_lite::wmatch_range;
+
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16match_range;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32match_range;
+#endif
+
+#if nssv_CPP11_OR_GREATER
+using sv_lite::sv_hash;
+using sv_lite::sv_hasher;
+using sv_lite::sv_equal;
+using sv_lite::basic_keyword_set;
+using sv_lite::basic_fixed_keyword_set;
+using sv_lite::basic_keyword_map;
+using sv_lite::basic_fixed_keyword_map;
+using sv_lite::make_keyword_set;
+using sv_lite::make_keyword_map;
+using sv_lite::keyword_set;
+using sv_lite::wkeyword_set;
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16keyword_set;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32keyword_set;
+#endif
+using sv_lite::basic_string_map;
+#if nssv_CONFIG_STRING_POOL
+using sv_lite::basic_string_pool;
+using sv_lite::string_pool;
+using sv_lite::wstring_pool;
+#if nssv_HAVE_WCHAR16_T
+using sv_lite::u16string_pool;
+#endif
+#if nssv_HAVE_WCHAR32_T
+using sv_lite::u32string_pool;
+#endif
+#endif
+#endif
+
 // literal "sv"
 
 using sv_lite::operator==;
+#if nssv_HAVE_THREE_WAY_COMPARISON
+using sv_lite::operator<=>;
+#else
 using sv_lite::operator!=;
 using sv_lite::operator<;
 using sv_lite::operator<=;
 using sv_lite::operator>;
 using sv_lite::operator>=;
+#endif
 
 #if ! nssv_CONFIG_NO_STREAM_INSERTION
 using sv_lite::operator<<;
@@ -1651,12 +6931,73 @@ using sv_lite::to_string_view;
 // 24.4.5 Hash support (C++11):
 
 // Note: The hash value of a string view object is equal to the hash value of
-// the corresponding string object.
+// the corresponding string object. The view's characters are hashed in place,
+// without constructing the string object, via std::hash of std::basic_string_view
+// (C++17), or via the byte hash that libstdc++'s std::hash of std::basic_string
+// uses (libstdc++ of GCC 7 and later). Otherwise the string object is constructed.
 
 #if nssv_HAVE_STD_HASH
 
 #include <functional>
 
+#if nssv_HAVE_STD_STRING_VIEW
+# include <string_view>
+#endif
+
+namespace nonstd { namespace sv_lite { namespace detail {
+
+template< typename CharT >
+inline std::size_t hash_chars( CharT const * s, std::size_t n, true_type /*std char*/ ) nssv_noexcept
+{
+#if nssv_HAVE_STD_STRING_VIEW
+    return std::hash< std::basic_string_view<CharT> >()( std::basic_string_view<CharT>( s, n ) );
+#elif defined(__GLIBCXX__) && defined(_GLIBCXX_RELEASE)
+    // the internal hash of libstdc++'s std::hash<std::basic_string>:
+    return std::_Hash_impl::hash( s, n * sizeof(CharT) );
+#else
+    return std::hash< std::basic_string<CharT> >()( std::basic_string<CharT>( s, n ) );
+#endif
+}
+
+// other character types: hash their bytes:
+
+template< typename CharT >
+inline std::size_t hash_chars( CharT const * s, std::size_t n, false_type /*std char*/ ) nssv_noexcept
+{
+    return hash_chars( reinterpret_cast<char const *>( s ), n * sizeof(CharT), true_type() );
+}
+
+template< typename CharT >
+inline std::size_t hash_chars( CharT const * s, std::size_t n ) nssv_noexcept
+{
+    return hash_chars( s, n, bool_constant< is_std_char_traits< CharT, std::char_traits<CharT> >::value >() );
+}
+
+}}} // namespace nonstd::sv_lite::detail
+
+namespace nonstd { namespace sv_lite { namespace detail {
+
+template< class CharT, class Traits, bool = hashes_by_value<Traits>::value >
+struct view_hash
+{
+    std::size_t operator()( basic_string_view<CharT, Traits> v ) const nssv_noexcept
+    {
+        return hash_chars( v.data(), v.size() );
+    }
+};
+
+// disabled, like std::hash of a type without a specialization:
+
+template< class CharT, class Traits >
+struct view_hash< CharT, Traits, false >
+{
+    view_hash() = delete;
+    view_hash( view_hash const & ) = delete;
+    view_hash & operator=( view_hash const & ) = delete;
+};
+
+}}} // namespace nonstd::sv_lite::detail
+
 namespace std {
 
 template<>
@@ -1665,7 +7006,7 @@ struct hash< nonstd::string_view >
 public:
     std::size_t operator()( nonstd::string_view v ) const nssv_noexcept
     {
-        return std::hash<std::string>()( std::string( v.data(), v.size() ) );
+        return nonstd::sv_lite::detail::hash_chars( v.data(), v.size() );
     }
 };
 
@@ -1675,7 +7016,7 @@ struct hash< nonstd::wstring_view >
 public:
     std::size_t operator()( nonstd::wstring_view v ) const nssv_noexcept
     {
-        return std::hash<std::wstring>()( std::wstring( v.data(), v.size() ) );
+        return nonstd::sv_lite::detail::hash_chars( v.data(), v.size() );
     }
 };
 
@@ -1685,7 +7026,7 @@ struct hash< nonstd::u16string_view >
 public:
     std::size_t operator()( nonstd::u16string_view v ) const nssv_noexcept
     {
-        return std::hash<std::u16string>()( std::u16string( v.data(), v.size() ) );
+        return nonstd::sv_lite::detail::hash_chars( v.data(), v.size() );
     }
 };
 
@@ -1695,10 +7036,18 @@ struct hash< nonstd::u32string_view >
 public:
     std::size_t operator()( nonstd::u32string_view v ) const nssv_noexcept
     {
-        return std::hash<std::u32string>()( std::u32string( v.data(), v.size() ) );
+        return nonstd::sv_lite::detail::hash_chars( v.data(), v.size() );
     }
 };
 
+// Views with other traits or of other character types hash their characters
+// as a view with std::char_traits would, if nonstd::hashes_by_value<Traits>
+// holds; otherwise std::hash is disabled (extension):
+
+template< class CharT, class Traits >
+struct hash< nonstd::basic_string_view<CharT, Traits> >
+    : nonstd::sv_lite::detail::view_hash<CharT, Traits> {};
+
 } // namespace std
 
 #endif // nssv_HAVE_STD_HASH
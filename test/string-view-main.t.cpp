@@ -42,6 +42,7 @@ CASE( "string-view-lite configuration" "[.string-view][.config]" )
     nssv_PRESENT( nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS );
     nssv_PRESENT( nssv_CONFIG_CONVERSION_STD_STRING_FREE_FUNCTIONS );
     nssv_PRESENT( nssv_CONFIG_NO_STREAM_INSERTION );
+    nssv_PRESENT( nssv_CONFIG_STRING_POOL );
     nssv_PRESENT( nssv_CONFIG_NO_EXCEPTIONS );
     nssv_PRESENT( nssv_CPLUSPLUS );
 }
@@ -80,6 +81,7 @@ CASE( "presence of C++ language features" "[.stdlanguage]" )
     nssv_PRESENT( nssv_HAVE_NOEXCEPT );
     nssv_PRESENT( nssv_HAVE_NULLPTR );
     nssv_PRESENT( nssv_HAVE_REF_QUALIFIER );
+    nssv_PRESENT( nssv_HAVE_THREE_WAY_COMPARISON );
     nssv_PRESENT( nssv_HAVE_UNICODE_LITERALS );
     nssv_PRESENT( nssv_HAVE_USER_DEFINED_LITERALS );
     nssv_PRESENT( nssv_HAVE_WCHAR16_T );
@@ -93,6 +95,7 @@ CASE( "presence of C++ library features" "[.stdlibrary]" )
 #if nssv_USES_STD_STRING_VIEW
     std::cout << "(C++ library features not available: using std::string_view)\n";
 #else
+    nssv_PRESENT( nssv_HAVE_INITIALIZER_LIST );
     nssv_PRESENT( nssv_HAVE_STD_HASH );
 #endif
 
@@ -112,6 +115,10 @@ CASE( "usage of compiler intrinsics" "[.intrinsics]" )
     nssv_PRESENT( nssv_HAVE_BUILTIN_CE     );
     nssv_PRESENT( nssv_HAVE_BUILTIN_MEMCMP );
     nssv_PRESENT( nssv_HAVE_BUILTIN_STRLEN );
+    nssv_PRESENT( nssv_HAVE_IS_CONSTANT_EVALUATED );
+    nssv_PRESENT( nssv_HAVE_SSE2 );
+    nssv_PRESENT( nssv_HAVE_SSSE3 );
+    nssv_PRESENT( nssv_HAVE_AVX2 );
 #endif
 }
 
@@ -6,8 +6,18 @@
 // (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include "string-view-main.t.hpp"
+#include <map>
 #include <vector>
 
+#if nssv_CPP11_OR_GREATER
+# include <unordered_map>
+# include <unordered_set>
+#endif
+
+#if nssv_CPP11_OR_GREATER && nssv_CONFIG_STRING_POOL
+# include <thread>
+#endif
+
 #ifndef  nssv_CONFIG_CONFIRMS_COMPILATION_ERRORS
 # define nssv_CONFIG_CONFIRMS_COMPILATION_ERRORS  0
 #endif
@@ -58,6 +68,58 @@ CASE( "string_view: Allows to construct from C-string" )
     EXPECT( *(sv.data() + 10) == 'd'       );
 }
 
+template< class CharT >
+bool construct_as_naive_length()
+{
+    std::vector<CharT> text( 200, CharT( 'x' ) );
+
+    for ( std::size_t start = 0; start != 40; ++start )
+    {
+        for ( std::size_t n = 0; n != 100; ++n )
+        {
+            text[start + n] = CharT();
+
+            if ( basic_string_view<CharT>( data( text ) + start ).size() != n )
+                return false;
+
+            text[start + n] = CharT( 'x' );
+        }
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to construct from C-string of any length and alignment" )
+{
+    EXPECT( construct_as_naive_length<char   >() );
+    EXPECT( construct_as_naive_length<wchar_t>() );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( construct_as_naive_length<char16_t>() );
+    EXPECT( construct_as_naive_length<char32_t>() );
+#endif
+}
+
+// literal of 8 * 4^5 = 8192 characters, for constant evaluation beyond
+// the compiler's constexpr recursion depth:
+
+#define sv_REPEAT4( s )       s s s s
+#define sv_LONG_LITERAL( s )  sv_REPEAT4( sv_REPEAT4( sv_REPEAT4( sv_REPEAT4( sv_REPEAT4( s ) ) ) ) )
+
+CASE( "string_view: Allows to constexpr-construct from a long C-string (C++11)" )
+{
+#if nssv_HAVE_CONSTEXPR_11
+    constexpr wstring_view wsv( sv_LONG_LITERAL( L"abcdefgh" ) );
+    constexpr string_view   sv( sv_LONG_LITERAL(  "abcdefgh" ) );
+
+    static_assert( wsv.size() == 8192, "" );
+    static_assert(  sv.size() == 8192, "" );
+#if nssv_HAVE_WCHAR16_T
+    static_assert( u16string_view( sv_LONG_LITERAL( u"abcdefgh" ) ).size() == 8192, "" );
+#endif
+#else
+    EXPECT( !!"C++11 constexpr is not available (no C++11)" );
+#endif
+}
+
 CASE( "string_view: Allows to copy-construct from empty string_view" )
 {
     string_view sv1;
@@ -411,6 +473,112 @@ CASE( "string_view: Allows to compare empty string_views as equal via compare(),
     EXPECT( string_view().compare( string_view() ) == 0 );
 }
 
+// views that share a prefix of random length, with character values below
+// and above the sign bit of the character type:
+
+template< class CharT >
+bool compare_as_lexicographical_compare( unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+    typedef std::char_traits<CharT>  traits;
+
+    const CharT values[] = { CharT( 'a' ), CharT( 'b' ), CharT( 0 ), static_cast<CharT>( ~0u ), static_cast<CharT>( ~0u >> 1 ), static_cast<CharT>( 1u << ( 8 * sizeof(CharT) - 1 ) ) };
+
+    for ( unsigned trial = 0; trial != 2000; ++trial )
+    {
+        std::vector<CharT> a( 1 + trial % 71 ), b;
+
+        for ( std::size_t i = 0; i != a.size(); ++i )
+        {
+            seed = seed * 1103515245u + 12345u;
+            a[i] = values[ ( seed >> 16 ) % 6 ];
+        }
+
+        b = a;
+        seed = seed * 1103515245u + 12345u;
+        const std::size_t at = ( seed >> 16 ) % a.size();
+        b[at] = values[ ( seed >> 8 ) % 6 ];
+        b.erase( b.end() - std::ptrdiff_t( trial % 3 == 0 ? ( seed >> 4 ) % ( b.size() - at ) : 0 ), b.end() );
+
+        const view va( data( a ), a.size() );
+        const view vb( data( b ), b.size() );
+
+        const bool less    = std::lexicographical_compare( a.begin(), a.end(), b.begin(), b.end(), traits::lt );
+        const bool greater = std::lexicographical_compare( b.begin(), b.end(), a.begin(), a.end(), traits::lt );
+
+        if ( ( va.compare( vb ) < 0 ) != less || ( va.compare( vb ) > 0 ) != greater )
+            return false;
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to compare views of any character type as a lexicographical compare would via compare(), (1)" )
+{
+    EXPECT( compare_as_lexicographical_compare<char   >( 1u ) );
+    EXPECT( compare_as_lexicographical_compare<wchar_t>( 2u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( compare_as_lexicographical_compare<char16_t>( 3u ) );
+    EXPECT( compare_as_lexicographical_compare<char32_t>( 4u ) );
+#endif
+}
+
+#if nssv_HAVE_WCHAR16_T
+
+// traits that order characters in reverse:
+
+struct reverse_traits : std::char_traits<char16_t>
+{
+    static nssv_constexpr bool lt( char16_t a, char16_t b ) { return b < a; }
+
+    static nssv_constexpr14 int compare( char16_t const * a, char16_t const * b, std::size_t n )
+    {
+        for ( std::size_t i = 0; i != n; ++i )
+        {
+            if ( lt( a[i], b[i] ) ) return -1;
+            if ( lt( b[i], a[i] ) ) return +1;
+        }
+        return 0;
+    }
+};
+
+#endif
+
+CASE( "string_view: Allows to compare views with custom traits that order characters via compare(), (1)" )
+{
+#if nssv_HAVE_WCHAR16_T
+    typedef basic_string_view<char16_t, reverse_traits> view;
+
+    const char16_t a[] = u"abcdefghijklmnopqrstuvwxyz-z";
+    const char16_t b[] = u"abcdefghijklmnopqrstuvwxyz-a";
+
+    EXPECT( view( a ).compare( view( b ) ) < 0 );
+    EXPECT( view( b ).compare( view( a ) ) > 0 );
+    EXPECT( view( a ).compare( view( a ) ) == 0 );
+#else
+    EXPECT( !!"char16_t is not available (no C++11)" );
+#endif
+}
+
+CASE( "string_view: Allows to constexpr-compare views with custom traits via compare() as at run time, (1) (C++14)" )
+{
+#if nssv_HAVE_CONSTEXPR_14 && nssv_HAVE_WCHAR16_T
+    typedef basic_string_view<char16_t, reverse_traits> view;
+
+    constexpr int less    = view( u"abc-z" ).compare( view( u"abc-a" ) );
+    constexpr int greater = view( u"abc-a" ).compare( view( u"abc-z" ) );
+
+    static_assert( less < 0 && greater > 0, "" );
+
+    const char16_t a[] = u"abc-z";
+    const char16_t b[] = u"abc-a";
+
+    EXPECT( view( a ).compare( view( b ) ) == less    );
+    EXPECT( view( b ).compare( view( a ) ) == greater );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
 CASE( "string_view: Allows to constexpr-compare string_views via compare(), (1) (C++14)" )
 {
 #if nssv_HAVE_CONSTEXPR_14
@@ -559,6 +727,143 @@ CASE( "string_view: Allows to search for a character, starting at position pos (
     EXPECT( sv.find('w', 7 ) == string_view::npos );
 }
 
+template< class CharT >
+bool find_char_at_every_position( std::size_t n )
+{
+    typedef basic_string_view<CharT> view;
+
+    std::vector<CharT> text( n, CharT('a') );
+
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        text[i] = CharT('x');
+        view sv( data( text ), n );
+
+        if ( sv.find( CharT('x')        ) != i          ) return false;
+        if ( sv.find( CharT('x'), i     ) != i          ) return false;
+        if ( sv.find( CharT('x'), i + 1 ) != view::npos ) return false;
+        if ( sv.find( CharT('y')        ) != view::npos ) return false;
+
+        text[i] = CharT('a');
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to search for a character in a long view, at any position via find(), (2)" )
+{
+    EXPECT( find_char_at_every_position<char   >( 200 ) );
+    EXPECT( find_char_at_every_position<wchar_t>( 200 ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( find_char_at_every_position<char16_t>( 200 ) );
+    EXPECT( find_char_at_every_position<char32_t>( 200 ) );
+#endif
+}
+
+// reference search, for comparison with the search engines:
+
+template< class CharT >
+std::size_t naive_find( basic_string_view<CharT> h, basic_string_view<CharT> n, std::size_t pos )
+{
+    for ( std::size_t i = pos; i < h.size() && i + n.size() <= h.size(); ++i )
+    {
+        std::size_t k = 0;
+        while ( k < n.size() && h[i + k] == n[k] )
+            ++k;
+        if ( k == n.size() )
+            return i;
+    }
+    return basic_string_view<CharT>::npos;
+}
+
+// generate text from a small alphabet with a linear congruential generator:
+
+template< class CharT >
+std::vector<CharT> make_text( std::size_t n, unsigned alphabet, unsigned & seed )
+{
+    std::vector<CharT> text( n );
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        seed = seed * 1103515245u + 12345u;
+        text[i] = static_cast<CharT>( 'a' + ( seed >> 16 ) % alphabet );
+    }
+    return text;
+}
+
+template< class CharT >
+bool find_substring_as_naive_search( unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 300; ++trial )
+    {
+        const unsigned alphabet = 1 + trial % 3;
+        std::vector<CharT> h = make_text<CharT>( 1 + trial % 97 * 3, alphabet, seed );
+        std::vector<CharT> n = make_text<CharT>( 1 + trial % 13    , alphabet, seed );
+
+        view hv( data( h ), h.size() );
+        view nv( data( n ), n.size() );
+
+        for ( std::size_t pos = 0; pos < h.size(); pos += 7 )
+        {
+            if ( hv.find( nv, pos ) != naive_find( hv, nv, pos ) )
+                return false;
+            if ( hv.find( hv.substr( h.size() / 2, n.size() ), pos ) != naive_find( hv, hv.substr( h.size() / 2, n.size() ), pos ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to search for a string_view substring as a naive search would via find(), (1)" )
+{
+    EXPECT( find_substring_as_naive_search<char   >( 1u ) );
+    EXPECT( find_substring_as_naive_search<wchar_t>( 2u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( find_substring_as_naive_search<char16_t>( 3u ) );
+    EXPECT( find_substring_as_naive_search<char32_t>( 4u ) );
+#endif
+}
+
+CASE( "string_view: Allows to search for a long periodic string_view substring via find(), (1)" )
+{
+    std::string h( 5000, 'a' );
+    std::string n( 1000, 'a' );
+    n += 'b';
+
+    string_view hv( h.data(), h.size() );
+
+    EXPECT( hv.find( string_view( n.data(), n.size() ) ) == string_view::npos );
+
+    h.replace( 3000, n.size(), n );
+    hv = string_view( h.data(), h.size() );
+
+    EXPECT( hv.find( string_view( n.data(), n.size() )       ) == size_type( 3000 ) );
+    EXPECT( hv.find( string_view( n.data(), n.size() ), 3000 ) == size_type( 3000 ) );
+    EXPECT( hv.find( string_view( n.data(), n.size() ), 3001 ) == string_view::npos );
+}
+
+CASE( "string_view: Allows to constexpr-search a long string_view via find(), (1) (C++11)" )
+{
+#if nssv_HAVE_CONSTEXPR_11
+    static_assert( string_view( sv_LONG_LITERAL( "abcdefgh" ) "needle" ).find( string_view( "needle" ) ) == 8192, "" );
+    static_assert( string_view( sv_LONG_LITERAL( "abcdefgh" ) ).find( string_view( "habc" ), 5000 ) == 5007, "" );
+    static_assert( string_view( sv_LONG_LITERAL( "abcdefgh" ) ).find( string_view( "hh" ) ) == string_view::npos, "" );
+#else
+    EXPECT( !!"C++11 constexpr is not available (no C++11)" );
+#endif
+}
+
+CASE( "string_view: Allows to constexpr-search a long string_view for a C-string via find(), (4) (C++11)" )
+{
+#if nssv_HAVE_CONSTEXPR_11
+    static_assert( string_view( sv_LONG_LITERAL( "abcdefgh" ) "needle" ).find( "needle" ) == 8192, "" );
+    static_assert( string_view( sv_LONG_LITERAL( "abcdefgh" ) ).find( "habc", 5000 ) == 5007, "" );
+    static_assert( string_view( sv_LONG_LITERAL( "abcdefgh" ) ).find( "hh" ) == string_view::npos, "" );
+#else
+    EXPECT( !!"C++11 constexpr is not available (no C++11)" );
+#endif
+}
+
 CASE( "string_view: Allows to search for a C-string substring, starting at position pos and of length n via find(), (3)" )
 {
     char hello[] = "hello world";
@@ -611,6 +916,78 @@ CASE( "string_view: Allows to search backwards for a character, starting at posi
     EXPECT( sv.rfind('w', 5 ) == string_view::npos );
 }
 
+template< class CharT >
+std::size_t naive_rfind( basic_string_view<CharT> h, basic_string_view<CharT> n, std::size_t pos )
+{
+    if ( n.size() > h.size() )
+        return basic_string_view<CharT>::npos;
+
+    for ( std::size_t i = (std::min)( h.size() - n.size(), pos ) + 1; i-- != 0; )
+    {
+        std::size_t k = 0;
+        while ( k < n.size() && h[i + k] == n[k] )
+            ++k;
+        if ( k == n.size() )
+            return i;
+    }
+    return basic_string_view<CharT>::npos;
+}
+
+template< class CharT >
+bool rfind_substring_as_naive_search( unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 300; ++trial )
+    {
+        const unsigned alphabet = 1 + trial % 3;
+        std::vector<CharT> h = make_text<CharT>( 1 + trial % 97 * 3, alphabet, seed );
+        std::vector<CharT> n = make_text<CharT>( 1 + trial % 13    , alphabet, seed );
+
+        view hv( data( h ), h.size() );
+        view nv( data( n ), n.size() );
+
+        for ( std::size_t pos = 0; pos < h.size() + 7; pos += 7 )
+        {
+            if ( hv.rfind( nv, pos ) != naive_rfind( hv, nv, pos ) )
+                return false;
+            if ( hv.rfind( nv[0], pos ) != naive_rfind( hv, nv.substr( 0, 1 ), pos ) )
+                return false;
+        }
+        if ( hv.rfind( nv ) != naive_rfind( hv, nv, view::npos ) )
+            return false;
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to search backwards as a naive search would via rfind(), (1) and (2)" )
+{
+    EXPECT( rfind_substring_as_naive_search<char   >( 1u ) );
+    EXPECT( rfind_substring_as_naive_search<wchar_t>( 2u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( rfind_substring_as_naive_search<char16_t>( 3u ) );
+    EXPECT( rfind_substring_as_naive_search<char32_t>( 4u ) );
+#endif
+}
+
+CASE( "string_view: Allows to search backwards for a long periodic string_view substring via rfind(), (1)" )
+{
+    std::string h( 5000, 'a' );
+    std::string n( 1000, 'a' );
+    n[0] = 'b';
+
+    string_view hv( h.data(), h.size() );
+
+    EXPECT( hv.rfind( string_view( n.data(), n.size() ) ) == string_view::npos );
+
+    h.replace( 1000, n.size(), n );
+    hv = string_view( h.data(), h.size() );
+
+    EXPECT( hv.rfind( string_view( n.data(), n.size() )       ) == size_type( 1000 ) );
+    EXPECT( hv.rfind( string_view( n.data(), n.size() ), 1000 ) == size_type( 1000 ) );
+    EXPECT( hv.rfind( string_view( n.data(), n.size() ),  999 ) == string_view::npos );
+}
+
 CASE( "string_view: Allows to search backwards for a C-string substring, starting at position pos and of length n via rfind(), (3)" )
 {
     char hello[] = "hello world";
@@ -738,6 +1115,68 @@ CASE( "string_view: Allows to search backwards for the first occurrence of any o
     EXPECT( sv.find_last_of(  "xwy",  5 ) == string_view::npos );
 }
 
+// reference searches for any of the characters of a set:
+
+template< class CharT >
+std::size_t naive_find_first_of( basic_string_view<CharT> h, basic_string_view<CharT> set, std::size_t pos )
+{
+    for ( std::size_t i = pos; i < h.size(); ++i )
+    {
+        for ( std::size_t k = 0; k != set.size(); ++k )
+            if ( h[i] == set[k] )
+                return i;
+    }
+    return basic_string_view<CharT>::npos;
+}
+
+template< class CharT >
+std::size_t naive_find_last_of( basic_string_view<CharT> h, basic_string_view<CharT> set, std::size_t pos )
+{
+    for ( std::size_t i = h.empty() ? 0 : (std::min)( h.size() - 1, pos ) + 1; i-- != 0; )
+    {
+        for ( std::size_t k = 0; k != set.size(); ++k )
+            if ( h[i] == set[k] )
+                return i;
+    }
+    return basic_string_view<CharT>::npos;
+}
+
+template< class CharT >
+bool find_of_set_as_naive_search( unsigned text_alphabet, unsigned set_alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 200; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( 1 + trial * 7 % 211, text_alphabet, seed );
+        std::vector<CharT> s = make_text<CharT>( 1 + trial % 40     , set_alphabet , seed );
+
+        view hv( data( h ), h.size() );
+        view sv( data( s ), s.size() );
+
+        for ( std::size_t pos = 0; pos < h.size() + 7; pos += 5 )
+        {
+            if ( hv.find_first_of( sv, pos ) != naive_find_first_of( hv, sv, pos ) )
+                return false;
+            if ( hv.find_last_of( sv, pos ) != naive_find_last_of( hv, sv, pos ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to search for any of the characters in a set as a naive search would via find_first_of(), find_last_of(), (1)" )
+{
+    EXPECT( find_of_set_as_naive_search<char   >(  26u, 256u, 1u ) );
+    EXPECT( find_of_set_as_naive_search<char   >( 256u, 256u, 2u ) );
+    EXPECT( find_of_set_as_naive_search<wchar_t>(  26u, 600u, 3u ) );
+    EXPECT( find_of_set_as_naive_search<wchar_t>( 600u, 600u, 4u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( find_of_set_as_naive_search<char16_t>( 600u, 600u, 5u ) );
+    EXPECT( find_of_set_as_naive_search<char32_t>( 600u, 600u, 6u ) );
+#endif
+}
+
 CASE( "string_view: Allows to search for the first character not specified in a string view, starting at position pos (default: 0) via find_first_not_of(), (1)" )
 {
     char hello[] = "hello world";
@@ -848,6 +1287,83 @@ CASE( "string_view: Allows to search backwards for  the first character not equa
     EXPECT( sv.find_last_not_of( "x"          ) == size_type( 10 ) );
 }
 
+// reference searches for any of the characters not in a set:
+
+template< class CharT >
+std::size_t naive_find_first_not_of( basic_string_view<CharT> h, basic_string_view<CharT> set, std::size_t pos )
+{
+    for ( std::size_t i = pos; i < h.size(); ++i )
+    {
+        if ( naive_find_first_of( set, h.substr( i, 1 ), 0 ) == basic_string_view<CharT>::npos )
+            return i;
+    }
+    return basic_string_view<CharT>::npos;
+}
+
+template< class CharT >
+std::size_t naive_find_last_not_of( basic_string_view<CharT> h, basic_string_view<CharT> set, std::size_t pos )
+{
+    for ( std::size_t i = h.empty() ? 0 : (std::min)( h.size() - 1, pos ) + 1; i-- != 0; )
+    {
+        if ( naive_find_first_of( set, h.substr( i, 1 ), 0 ) == basic_string_view<CharT>::npos )
+            return i;
+    }
+    return basic_string_view<CharT>::npos;
+}
+
+template< class CharT >
+bool find_not_of_set_as_naive_search( unsigned text_alphabet, unsigned set_alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 200; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( 1 + trial * 7 % 211, text_alphabet, seed );
+        std::vector<CharT> s = make_text<CharT>(     trial % 40     , set_alphabet , seed );
+
+        // mostly characters of the set, to find one that is not:
+
+        for ( std::size_t i = 0; i < h.size() && ! s.empty(); ++i )
+            if ( i % ( 1 + trial % 67 ) != 0 )
+                h[i] = s[ i % s.size() ];
+
+        view hv( data( h ), h.size() );
+        view sv( data( s ), s.size() );
+
+        for ( std::size_t pos = 0; pos < h.size() + 7; pos += 5 )
+        {
+            if ( hv.find_first_not_of( sv, pos ) != naive_find_first_not_of( hv, sv, pos ) )
+                return false;
+            if ( hv.find_last_not_of( sv, pos ) != naive_find_last_not_of( hv, sv, pos ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+CASE( "string_view: Allows to search for any of the characters not in a set as a naive search would via find_first_not_of(), find_last_not_of(), (1)" )
+{
+    EXPECT( find_not_of_set_as_naive_search<char   >(  26u, 256u, 1u ) );
+    EXPECT( find_not_of_set_as_naive_search<char   >( 256u,  26u, 2u ) );
+    EXPECT( find_not_of_set_as_naive_search<wchar_t>(  26u, 600u, 3u ) );
+    EXPECT( find_not_of_set_as_naive_search<wchar_t>( 600u, 600u, 4u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( find_not_of_set_as_naive_search<char16_t>( 600u, 600u, 5u ) );
+    EXPECT( find_not_of_set_as_naive_search<char32_t>( 600u, 600u, 6u ) );
+#endif
+}
+
+CASE( "string_view: Allows to constexpr-search for a character not in a set via find_first_not_of(), find_last_not_of(), (1) (C++14)" )
+{
+#if nssv_HAVE_CONSTEXPR_14
+    static_assert( string_view( " \t hello \t " ).find_first_not_of( string_view( " \t" ) ) == 3, "" );
+    static_assert( string_view( " \t hello \t " ).find_last_not_of ( string_view( " \t" ) ) == 7, "" );
+    static_assert( string_view( " \t \t" ).find_first_not_of( string_view( " \t" ) ) == string_view::npos, "" );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
 CASE( "string_view: Allows to create a string_view, wstring_view, u16string_view, u32string_view via literal \"sv\"" )
 {
 #if nssv_CONFIG_STD_SV_OPERATOR
@@ -1084,6 +1600,30 @@ CASE( "string_view: Allows to compare a string_view with an object with implicit
     EXPECT(       "world" >= sv );
 }
 
+CASE( "string_view: Allows to compare a string_view with another string_view and with a C-string via three-way comparison (C++20)" )
+{
+#if nssv_CPP20_OR_GREATER && defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+    char s[] = "hello";
+    char t[] = "world";
+    string_view sv( s );
+    string_view tv( t );
+
+    EXPECT( ( std::is_same< decltype( sv <=> tv ), std::strong_ordering >::value ) );
+
+    EXPECT( ( ( sv <=> sv ) == 0 ) );
+    EXPECT( ( ( sv <=> tv ) <  0 ) );
+    EXPECT( ( ( tv <=> sv ) >  0 ) );
+    EXPECT( ( ( sv <=> "hello" ) == 0 ) );
+    EXPECT( ( ( "world" <=> sv ) >  0 ) );
+    EXPECT( ( ( sv <=> string_view( s, 4 ) ) > 0 ) );
+    EXPECT( ( ( string_view() <=> sv ) < 0 ) );
+
+    EXPECT( std::ranges::is_sorted( std::vector<string_view>{ "", "a", "ab", "b", "hello", "world" } ) );
+#else
+    EXPECT( !!"operator<=> is not available (no C++20)." );
+#endif
+}
+
 CASE( "string_view: Allows to compare empty string_view-s as equal via compare() and via operator==()" )
 {
     string_view a, b;
@@ -1092,6 +1632,42 @@ CASE( "string_view: Allows to compare empty string_view-s as equal via compare()
     EXPECT( a.compare( b ) == 0 );
 }
 
+// differ at each position of views of each size and offset:
+
+inline bool equal_as_compare()
+{
+    const std::string text( 48, 'x' );
+    bool ok = true;
+
+    for ( size_type offset = 0; offset != 8; ++offset )
+    {
+        for ( size_type n = 0; n <= 40; ++n )
+        {
+            std::string other( text );
+            const string_view sv( text.data() + offset, n );
+
+            ok = ok && sv == sv && sv == string_view( other.data() + offset, n );
+            ok = ok && sv != string_view( text.data(), n + 1 ) && ( n == 0 || sv != string_view( text.data(), n / 2 ) );
+
+            for ( size_type i = 0; i != n; ++i )
+            {
+                other[ offset + i ] = 'y';
+                const string_view ov( other.data() + offset, n );
+
+                ok = ok && ( sv == ov ) == ( sv.compare( ov ) == 0 ) && sv != ov && ov != sv;
+
+                other[ offset + i ] = 'x';
+            }
+        }
+    }
+    return ok;
+}
+
+CASE( "string_view: Allows to compare short and long string_views for equality as via compare()" )
+{
+    EXPECT( equal_as_compare() );
+}
+
 // 24.4.4 Inserters and extractors:
 
 CASE ( "operator<<: Allows printing a string_view to an output stream" )
@@ -1166,33 +1742,93 @@ CASE ( "std::hash<>: Hash value of u32string_view equals hash value of correspon
 #endif
 }
 
-// nonstd extension: conversions from and to std::basic_string
-
-CASE( "string_view: construct from std::string " "[extension]" )
+CASE ( "std::hash<>: Hash value of a long string_view equals hash value of corresponding string object" )
 {
-#if nssv_USES_STD_STRING_VIEW
-    EXPECT( !!"Conversion to/from std::string is not available (nssv_USES_STD_STRING_VIEW=1)." );
-#elif nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
-    char hello[]  = "hello world";
-    std::string s =  hello;
-
-    string_view sv( hello );
+#if nssv_HAVE_STD_HASH
+    const std::string  s( 1000, 'x' );
+    const std::wstring w( 1000, L'x' );
 
-    EXPECT( sv.size() == s.size() );
-    EXPECT( sv.compare( s ) == 0  );
+    EXPECT( std::hash<string_view >()( s ) == std::hash<std::string >()( s ) );
+    EXPECT( std::hash<wstring_view>()( w ) == std::hash<std::wstring>()( w ) );
+    EXPECT( std::hash<string_view >()( string_view( s ).substr( 1 ) ) == std::hash<std::string>()( s.substr( 1 ) ) );
 #else
-    EXPECT( !!"Conversion to/from std::string is not available (nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS=0)." );
+    EXPECT( !!"std::hash is not available (no C++11)" );
 #endif
 }
 
-CASE( "string_view: convert to std::string via explicit operator " "[extension]" )
-{
-#if nssv_USES_STD_STRING_VIEW
-    EXPECT( !!"Conversion to/from std::string is not available (nssv_USES_STD_STRING_VIEW=1)." );
-#elif nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
-#if nssv_HAVE_EXPLICIT_CONVERSION
-    char hello[] = "hello world";
-    string_view sv( hello );
+} // anonymous namespace
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER && nssv_HAVE_WCHAR16_T
+
+// reverse_traits::eq() compares character values:
+
+namespace nonstd {
+template<> struct hashes_by_value< reverse_traits > : std::true_type {};
+}
+
+#endif
+
+namespace {
+
+CASE ( "std::hash<>: Hash value of a view with custom traits equals hash value of the view with std::char_traits " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"std::hash of basic_string_view with custom traits is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_STD_HASH && nssv_HAVE_WCHAR16_T && nssv_HAVE_UNICODE_LITERALS
+    typedef basic_string_view<char16_t, reverse_traits> view;
+
+    EXPECT( std::hash<view>()( u"Hello, world!" ) == std::hash<u16string_view>()( u"Hello, world!" ) );
+#else
+    EXPECT( !!"std::hash or char16_t is not available (no C++11)" );
+#endif
+}
+
+CASE ( "std::hash<>: Hash of a view with custom traits is disabled unless nonstd::hashes_by_value holds " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"std::hash of basic_string_view with custom traits is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_STD_HASH
+    struct nocase_traits : std::char_traits<char>
+    {
+        static bool eq( char a, char b ) { return ( a | 0x20 ) == ( b | 0x20 ); }
+    };
+
+    EXPECT(   hashes_by_value< std::char_traits<char> >::value );
+    EXPECT( ! hashes_by_value< nocase_traits >::value );
+    EXPECT(   ( std::is_default_constructible< std::hash< basic_string_view<char, std::char_traits<char> > > >::value ) );
+    EXPECT( ! ( std::is_default_constructible< std::hash< basic_string_view<char, nocase_traits> > >::value ) );
+#else
+    EXPECT( !!"std::hash is not available (no C++11)" );
+#endif
+}
+
+// nonstd extension: conversions from and to std::basic_string
+
+CASE( "string_view: construct from std::string " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"Conversion to/from std::string is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
+    char hello[]  = "hello world";
+    std::string s =  hello;
+
+    string_view sv( hello );
+
+    EXPECT( sv.size() == s.size() );
+    EXPECT( sv.compare( s ) == 0  );
+#else
+    EXPECT( !!"Conversion to/from std::string is not available (nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS=0)." );
+#endif
+}
+
+CASE( "string_view: convert to std::string via explicit operator " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"Conversion to/from std::string is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CONFIG_CONVERSION_STD_STRING_CLASS_METHODS
+#if nssv_HAVE_EXPLICIT_CONVERSION
+    char hello[] = "hello world";
+    string_view sv( hello );
 
     std::string s( sv );
 //  std::string t{ sv };
@@ -1265,6 +1901,1397 @@ CASE( "to_string_view(): convert from std::string via to_string_view() " "[exten
 #endif
 }
 
+// nonstd extension: searcher for repeated lookup of the same needle
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+template< class CharT >
+bool searcher_finds_as_find( unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 200; ++trial )
+    {
+        const unsigned alphabet = 1 + trial % 4;
+        std::vector<CharT> h = make_text<CharT>( 1 + trial % 89 * 5, alphabet, seed );
+        std::vector<CharT> n = make_text<CharT>( trial % 23        , alphabet, seed );
+
+        view hv( data( h ), h.size() );
+        view nv( n.empty() ? nssv_nullptr : data( n ), n.size() );
+
+        basic_searcher<CharT> s( nv );
+
+        for ( std::size_t pos = 0; pos < h.size() + 2; pos += 3 )
+        {
+            if ( s.find( hv, pos ) != hv.find( nv, pos ) )
+                return false;
+        }
+
+        view mid = hv.substr( h.size() / 3, n.size() );
+        basic_searcher<CharT> t( mid );
+
+        if ( t.find( hv ) != hv.find( mid ) )
+            return false;
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "searcher: Allows to search for a needle as via string_view find() " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( searcher_finds_as_find<char   >( 5u ) );
+    EXPECT( searcher_finds_as_find<wchar_t>( 6u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( searcher_finds_as_find<char16_t>( 7u ) );
+    EXPECT( searcher_finds_as_find<char32_t>( 8u ) );
+#endif
+#endif
+}
+
+CASE( "searcher: Allows to search for a needle via the searcher interface of std::search() " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    string_view hay( "multipart boundary: --boundary--" );
+    searcher s( "boundary" );
+
+    EXPECT( s( hay.begin(), hay.end() ).first  == hay.begin() + 10 );
+    EXPECT( s( hay.begin(), hay.end() ).second == hay.begin() + 18 );
+    EXPECT( s( hay.begin() + 11, hay.end() ).first == hay.begin() + 22 );
+    EXPECT( s( hay.begin() + 23, hay.end() ).first == hay.end() );
+#endif
+}
+
+// nonstd extension: prepared set of characters for find_first_of() and friends
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+template< class CharT >
+bool char_set_finds_as_view( unsigned alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 200; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( 1 + trial * 7 % 211, alphabet, seed );
+        std::vector<CharT> s = make_text<CharT>( 1 + trial % 40     , alphabet, seed );
+
+        view hv( data( h ), h.size() );
+        view sv( data( s ), s.size() );
+
+        basic_char_set<CharT> set( sv );
+
+        for ( std::size_t pos = 0; pos < h.size() + 7; pos += 5 )
+        {
+            if ( hv.find_first_of    ( set, pos ) != hv.find_first_of    ( sv, pos ) ) return false;
+            if ( hv.find_last_of     ( set, pos ) != hv.find_last_of     ( sv, pos ) ) return false;
+            if ( hv.find_first_not_of( set, pos ) != hv.find_first_not_of( sv, pos ) ) return false;
+            if ( hv.find_last_not_of ( set, pos ) != hv.find_last_not_of ( sv, pos ) ) return false;
+        }
+    }
+    return true;
+}
+
+// traits that compare ASCII letters regardless of case:
+
+struct ci_traits : std::char_traits<char>
+{
+    static char lower( char c ) { return 'A' <= c && c <= 'Z' ? static_cast<char>( c - 'A' + 'a' ) : c; }
+
+    static bool eq( char a, char b ) { return lower( a ) == lower( b ); }
+    static bool lt( char a, char b ) { return lower( a ) <  lower( b ); }
+
+    static char const * find( char const * s, std::size_t n, char c )
+    {
+        for ( ; n != 0; --n, ++s )
+            if ( eq( *s, c ) )
+                return s;
+        return nssv_nullptr;
+    }
+};
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "char_set: Allows to search for characters of a prepared set as via string_view find_first_of() and friends " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_char_set is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( char_set_finds_as_view<char   >(  40u, 1u ) );
+    EXPECT( char_set_finds_as_view<char   >( 256u, 2u ) );
+    EXPECT( char_set_finds_as_view<wchar_t>( 600u, 3u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( char_set_finds_as_view<char16_t>( 600u, 4u ) );
+    EXPECT( char_set_finds_as_view<char32_t>( 600u, 5u ) );
+#endif
+#endif
+}
+
+CASE( "char_set: Allows to search for characters of a prepared set, with traits other than std::char_traits " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_char_set is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    typedef basic_string_view<char, ci_traits> ci_view;
+
+    ci_view hay( "Hello, World" );
+    basic_char_set<char, ci_traits> set( "wh" );
+
+    EXPECT( set.contains( 'W' ) );
+    EXPECT( hay.find_first_of( set ) == size_type( 0 ) );
+    EXPECT( hay.find_last_of ( set ) == size_type( 7 ) );
+    EXPECT( hay.find_first_not_of( set ) == size_type(  1 ) );
+    EXPECT( hay.find_last_not_of ( set ) == size_type( 11 ) );
+#endif
+}
+
+CASE( "char_set: Allows to construct a set of characters at compile time (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_char_set is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    constexpr char_set ws( " \t\r\n" );
+
+    static_assert(   ws.contains( '\t' ), "" );
+    static_assert( ! ws.contains( 'x'  ), "" );
+    static_assert( ws.chars().size() == 4, "" );
+
+    string_view line( " \t key = value \r\n" );
+
+    EXPECT( line.find_first_not_of( ws ) == size_type(  3 ) );
+    EXPECT( line.find_last_not_of ( ws ) == size_type( 13 ) );
+    EXPECT( line.find_first_of( ws, 3 )  == size_type(  6 ) );
+    EXPECT( line.find_last_of ( ws, 13 ) == size_type(  8 ) );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+// nonstd extension: Aho-Corasick automaton for many needles at once
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+typedef std::vector< std::pair<std::size_t, std::size_t> > matches;
+
+struct collect_matches
+{
+    matches * out;
+
+    explicit collect_matches( matches & out_ ) : out( &out_ ) {}
+
+    void operator()( std::size_t pattern, std::size_t pos ) const
+    {
+        out->push_back( std::make_pair( pattern, pos ) );
+    }
+};
+
+// all matches in the order of their end, longest, then lowest id first:
+
+template< class CharT >
+matches naive_find_all( basic_string_view<CharT> h, std::vector< basic_string_view<CharT> > const & patterns )
+{
+    matches result;
+
+    for ( std::size_t end = 1; end <= h.size(); ++end )
+    {
+        for ( std::size_t len = end; len != 0; --len )
+        {
+            for ( std::size_t p = 0; p != patterns.size(); ++p )
+            {
+                if ( patterns[p].size() == len && h.substr( end - len, len ) == patterns[p] )
+                    result.push_back( std::make_pair( p, end - len ) );
+            }
+        }
+    }
+    return result;
+}
+
+template< class CharT >
+bool multi_searcher_finds_as_naive_search( unsigned alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 100; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( 1 + trial * 3 % 157, alphabet, seed );
+        std::vector<CharT> t = make_text<CharT>( 200, alphabet, seed );
+
+        std::vector<view> patterns;
+        for ( std::size_t i = 0; i != 1 + trial % 20; ++i )
+            patterns.push_back( view( data( t ) + i * 7, i % 6 ) );
+
+        basic_multi_searcher<CharT> ms( patterns.begin(), patterns.end() );
+
+        view hv( data( h ), h.size() );
+        matches expected = naive_find_all( hv, patterns );
+        matches found;
+
+        ms.find_all( hv, collect_matches( found ) );
+
+        if ( found != expected )
+            return false;
+
+        for ( std::size_t pos = 0; pos < h.size() + 2; pos += 5 )
+        {
+            typename basic_multi_searcher<CharT>::match m = ms.find( hv, pos );
+
+            std::size_t k = 0;
+            while ( k != expected.size() && expected[k].second < pos )
+                ++k;
+
+            if ( k == expected.size() ? m.pattern != view::npos || m.pos != view::npos : m.pattern != expected[k].first || m.pos != expected[k].second )
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "multi_searcher: Allows to find all occurrences of many patterns in a single pass " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_multi_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( multi_searcher_finds_as_naive_search<char   >(   2u, 1u ) );
+    EXPECT( multi_searcher_finds_as_naive_search<char   >( 256u, 2u ) );
+    EXPECT( multi_searcher_finds_as_naive_search<wchar_t>(   3u, 3u ) );
+    EXPECT( multi_searcher_finds_as_naive_search<wchar_t>( 600u, 4u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( multi_searcher_finds_as_naive_search<char16_t>( 600u, 5u ) );
+    EXPECT( multi_searcher_finds_as_naive_search<char32_t>(   4u, 6u ) );
+#endif
+#endif
+}
+
+CASE( "multi_searcher: Allows to find the first occurrence of any of many patterns " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_multi_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    char const * tokens[] = { "he", "she", "his", "hers" };
+    multi_searcher ms( tokens, tokens + 4 );
+
+    EXPECT( ms.size() == size_type( 4 ) );
+    EXPECT( ms.length( 3 ) == size_type( 4 ) );
+
+    EXPECT( ms.find( "ushers" ).pattern == size_type( 1 ) );
+    EXPECT( ms.find( "ushers" ).pos     == size_type( 1 ) );
+    EXPECT( ms.find( "ushers", 2 ).pattern == size_type( 0 ) );
+    EXPECT( ms.find( "ushers", 2 ).pos     == size_type( 2 ) );
+    EXPECT( ms.find( "ushers", 3 ).pattern == multi_searcher::npos );
+
+    matches found;
+    ms.find_all( "ushers", collect_matches( found ) );
+
+    EXPECT( found.size() == size_type( 3 ) );
+    EXPECT( found[0] == std::make_pair( size_type( 1 ), size_type( 1 ) ) );
+    EXPECT( found[1] == std::make_pair( size_type( 0 ), size_type( 2 ) ) );
+    EXPECT( found[2] == std::make_pair( size_type( 3 ), size_type( 2 ) ) );
+
+#if nssv_HAVE_INITIALIZER_LIST
+    multi_searcher methods( { "GET ", "POST ", "PUT " } );
+
+    EXPECT( methods.find( "> POST /upload" ).pattern == size_type( 1 ) );
+#endif
+#endif
+}
+
+CASE( "multi_searcher: Allows to find patterns with traits other than std::char_traits " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_multi_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    char const * tokens[] = { "select", "drop" };
+    basic_multi_searcher<char, ci_traits> ms( tokens, tokens + 2 );
+
+    EXPECT( ms.find( "x; DROP table" ).pattern == size_type( 1 ) );
+    EXPECT( ms.find( "x; DROP table" ).pos     == size_type( 3 ) );
+    EXPECT( ms.find( "SeLeCt *"      ).pattern == size_type( 0 ) );
+#endif
+}
+
+// nonstd extension: packed searcher for a few short needles at once
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+template< class CharT >
+bool packed_searcher_finds_as_find( unsigned alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 300; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( 1 + trial * 5 % 233, alphabet, seed );
+        std::vector<CharT> t = make_text<CharT>( 100, alphabet, seed );
+
+        std::vector<view> needles;
+        for ( std::size_t i = 0; i != 1 + trial % 10; ++i )
+            needles.push_back( view( data( t ) + i * 9, ( trial + i ) % 7 + ( trial % 29 != 0 ) ) );
+
+        basic_packed_searcher<CharT> ps( needles.begin(), needles.end() );
+        view hv( data( h ), h.size() );
+
+        for ( std::size_t pos = 0; pos < h.size() + 3; pos += 4 )
+        {
+            std::size_t id = view::npos, at = view::npos;
+
+            for ( std::size_t k = 0; k != needles.size(); ++k )
+            {
+                if ( hv.find( needles[k], pos ) < at )
+                {
+                    id = k;
+                    at = hv.find( needles[k], pos );
+                }
+            }
+
+            typename basic_packed_searcher<CharT>::match m = ps.find_match( hv, pos );
+
+            if ( m.pattern != id || m.pos != at || ps.find( hv, pos ) != at )
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "packed_searcher: Allows to search for the leftmost of a few needles as via string_view find() " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_packed_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( packed_searcher_finds_as_find<char   >(   3u, 1u ) );
+    EXPECT( packed_searcher_finds_as_find<char   >( 256u, 2u ) );
+    EXPECT( packed_searcher_finds_as_find<wchar_t>(   3u, 3u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( packed_searcher_finds_as_find<char16_t>( 3u, 4u ) );
+    EXPECT( packed_searcher_finds_as_find<char32_t>( 3u, 5u ) );
+#endif
+#endif
+}
+
+CASE( "packed_searcher: Allows to search for request methods " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_packed_searcher is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    char const * methods[] = { "GET ", "POST ", "HTTP/" };
+    packed_searcher ps( methods, methods + 3 );
+
+    string_view text( "Content-Length: 0\r\n\r\nPOST /form HTTP/1.1\r\n" );
+
+    EXPECT( ps.size() == size_type( 3 ) );
+    EXPECT( ps.needle( 2 ) == "HTTP/" );
+    EXPECT( ps.find( text ) == size_type( 21 ) );
+    EXPECT( ps.find_match( text ).pattern == size_type( 1 ) );
+    EXPECT( ps.find( text, 22 ) == size_type( 32 ) );
+    EXPECT( ps.find_match( text, 22 ).pattern == size_type( 2 ) );
+    EXPECT( ps.find( text, 33 ) == packed_searcher::npos );
+#endif
+}
+
+// nonstd extension: lazy range of the occurrences of a needle
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+template< class CharT >
+std::vector<std::size_t> naive_find_all( basic_string_view<CharT> h, basic_string_view<CharT> v, find_mode mode )
+{
+    std::vector<std::size_t> result;
+
+    for ( std::size_t pos = h.find( v ); pos != h.npos; )
+    {
+        result.push_back( pos );
+        pos = h.find( v, pos + ( mode == find_overlapping || v.empty() ? 1 : v.size() ) );
+    }
+    return result;
+}
+
+template< class CharT >
+bool find_all_as_repeated_find( basic_string_view<CharT> h, basic_string_view<CharT> v, find_mode mode )
+{
+    typedef basic_match_range<CharT> range;
+
+    std::vector<std::size_t> found;
+    range r = find_all( h, v, mode );
+
+    for ( typename range::iterator it = r.begin(); it != r.end(); ++it )
+    {
+        if ( it.view() != v || it.view().data() != h.data() + *it )
+            return false;
+
+        found.push_back( *it );
+    }
+    return found == naive_find_all( h, v, mode );
+}
+
+template< class CharT >
+bool find_all_finds_as_find( unsigned alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 200; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( trial * 17 % 3001, alphabet, seed );
+        view hv( data( h ), h.size() );
+
+        // needles from the text, mostly found, some at random:
+
+        for ( std::size_t m = 0; m < 24 && m <= h.size(); m += 1 + m / 4 )
+        {
+            const view v = hv.substr( ( trial * 31 ) % ( h.size() - m + 1 ), m );
+
+            if ( ! find_all_as_repeated_find( hv, v, find_overlapping     )
+              || ! find_all_as_repeated_find( hv, v, find_non_overlapping ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "find_all(): Allows to iterate over all occurrences of a needle as via repeated find() " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"find_all() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( find_all_finds_as_find<char   >(   2u, 1u ) );
+    EXPECT( find_all_finds_as_find<char   >( 256u, 2u ) );
+    EXPECT( find_all_finds_as_find<wchar_t>(   3u, 3u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( find_all_finds_as_find<char16_t>( 2u, 4u ) );
+    EXPECT( find_all_finds_as_find<char32_t>( 2u, 5u ) );
+#endif
+#endif
+}
+
+CASE( "find_all(): Allows to iterate over overlapping occurrences of a periodic needle " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"find_all() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    const std::string a( 5000, 'a' );
+    const std::string ab = std::string( 3000, 'a' ) + "ba" + std::string( 3000, 'a' );
+
+    EXPECT( find_all_as_repeated_find( string_view( a  ), string_view( a.data(), 40 ), find_overlapping     ) );
+    EXPECT( find_all_as_repeated_find( string_view( a  ), string_view( a.data(), 40 ), find_non_overlapping ) );
+    EXPECT( find_all_as_repeated_find( string_view( ab ), string_view( ab.data() + 2980, 30 ), find_overlapping ) );
+#endif
+}
+
+CASE( "find_all(): Allows to iterate over all occurrences of a character " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"find_all() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    string_view text( "a,b,,c" );
+    std::vector<std::size_t> commas;
+
+    match_range r = find_all( text, ',' );
+
+    for ( match_range::iterator it = r.begin(); it != r.end(); ++it )
+        commas.push_back( *it );
+
+    EXPECT( commas.size() == std::size_t( 3 ) );
+    EXPECT( commas[0] == size_type( 1 ) );
+    EXPECT( commas[1] == size_type( 3 ) );
+    EXPECT( commas[2] == size_type( 4 ) );
+    EXPECT( r.needle() == "," );
+    EXPECT( find_all( text, ';' ).empty() );
+#endif
+}
+
+CASE( "find_all(): Allows to select non-overlapping occurrences " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"find_all() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    std::size_t overlapping = 0, non_overlapping = 0;
+
+    match_range r1 = find_all( string_view( "aaaaa" ), "aa" );
+    match_range r2 = find_all( string_view( "aaaaa" ), "aa", find_non_overlapping );
+
+    for ( match_range::iterator it = r1.begin(); it != r1.end(); ++it ) ++overlapping;
+    for ( match_range::iterator it = r2.begin(); it != r2.end(); it++ ) ++non_overlapping;
+
+    EXPECT( overlapping     == std::size_t( 4 ) );
+    EXPECT( non_overlapping == std::size_t( 2 ) );
+    EXPECT( *++r2.begin() == size_type( 2 ) );
+#endif
+}
+
+// nonstd extension: count of characters and of substrings
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+template< class CharT >
+std::size_t naive_count( basic_string_view<CharT> h, basic_string_view<CharT> v )
+{
+    std::size_t result = 0;
+
+    for ( std::size_t pos = h.find( v ); pos != h.npos; pos = h.find( v, pos + ( v.empty() ? 1 : v.size() ) ) )
+        ++result;
+
+    return result;
+}
+
+template< class CharT >
+bool count_as_repeated_find( unsigned alphabet, unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( unsigned trial = 0; trial != 200; ++trial )
+    {
+        std::vector<CharT> h = make_text<CharT>( trial * trial % 10007, alphabet, seed );
+        view hv( data( h ), h.size() );
+
+        for ( std::size_t m = 0; m < 12 && m <= h.size(); m += 1 + m / 3 )
+        {
+            const view v = hv.substr( ( trial * 31 ) % ( h.size() - m + 1 ), m );
+
+            if ( hv.count( v ) != naive_count( hv, v ) )
+                return false;
+
+            if ( m == 1 && hv.count( v[0] ) != naive_count( hv, v ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "string_view: Allows to count the occurrences of a character or substring as via repeated find() " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"count() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( count_as_repeated_find<char   >(   2u, 1u ) );
+    EXPECT( count_as_repeated_find<char   >( 256u, 2u ) );
+    EXPECT( count_as_repeated_find<wchar_t>(   3u, 3u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( count_as_repeated_find<char16_t>( 2u, 4u ) );
+    EXPECT( count_as_repeated_find<char32_t>( 2u, 5u ) );
+#endif
+#endif
+}
+
+CASE( "string_view: Allows to count lines and non-overlapping occurrences " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"count() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    std::string text;
+    for ( int i = 0; i != 10000; ++i )
+        text += "line\n";
+
+    EXPECT( string_view( text ).count( '\n' ) == size_type( 10000 ) );
+    EXPECT( string_view( text ).count( "ne\nli" ) == size_type( 9999 ) );
+    EXPECT( string_view( std::string( 10000, 'a' ) ).count( 'a' ) == size_type( 10000 ) );
+    EXPECT( string_view( "aaaaa" ).count( "aa" ) == size_type( 2 ) );
+    EXPECT( string_view( "aaaaa" ).count( "b"  ) == size_type( 0 ) );
+    EXPECT( string_view().count( 'a' ) == size_type( 0 ) );
+#endif
+}
+
+CASE( "string_view: Allows to constexpr-count characters and substrings (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"count() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    static_assert( string_view( "a,b,,c" ).count( ',' ) == 3, "" );
+    static_assert( string_view( "abababa" ).count( string_view( "aba" ) ) == 2, "" );
+    static_assert( string_view( "abc" ).count( string_view( "" ) ) == 3, "" );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+// nonstd extension: ASCII case-insensitive comparison and search
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+// text of letters in either case and characters around 'A'-'Z' and 'a'-'z':
+
+template< class CharT >
+std::vector<CharT> make_mixed_case_text( std::size_t n, unsigned & seed )
+{
+    static const unsigned char extra[] = { '@', '[', '`', '{', 0xC1, 0xE1, 0xDA };
+
+    std::vector<CharT> text( n );
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        seed = seed * 1103515245u + 12345u;
+        const unsigned r = ( seed >> 16 ) % 16;
+        text[i] = r < 3 ? static_cast<CharT>( 'a' + r ) : r < 6 ? static_cast<CharT>( 'A' + r - 3 ) : r < 9 ? static_cast<CharT>( extra[r - 6] ) : static_cast<CharT>( 'a' );
+    }
+    return text;
+}
+
+template< class CharT >
+std::basic_string<CharT> to_lower( basic_string_view<CharT> v )
+{
+    std::basic_string<CharT> result( v.begin(), v.end() );
+    for ( std::size_t i = 0; i != result.size(); ++i )
+        if ( 'A' <= result[i] && result[i] <= 'Z' )
+            result[i] = static_cast<CharT>( result[i] - 'A' + 'a' );
+    return result;
+}
+
+inline int sign( int x )
+{
+    return x < 0 ? -1 : x > 0 ? 1 : 0;
+}
+
+template< class CharT >
+bool case_insensitive_as_lowercase_copies( unsigned seed )
+{
+    typedef basic_string_view<CharT> view;
+    typedef std::basic_string<CharT> string;
+
+    for ( unsigned trial = 0; trial != 300; ++trial )
+    {
+        std::vector<CharT> h = make_mixed_case_text<CharT>( trial * 13 % 701, seed );
+        std::vector<CharT> t = make_mixed_case_text<CharT>( 1 + trial % 40  , seed );
+
+        view hv( data( h ), h.size() );
+        view tv( data( t ), t.size() );
+
+        const string hl = to_lower( hv );
+        const string tl = to_lower( tv );
+
+        for ( std::size_t m = 0; m <= 40 && m <= h.size(); m += 1 + m / 3 )
+        {
+            const view v = hv.substr( trial % ( h.size() - m + 1 ), m );
+            const string vl = to_lower( v );
+
+            if ( sign( hv.icompare( v ) ) != sign( hl.compare( vl ) ) )
+                return false;
+            if ( hv.iequals( v ) != ( hl == vl ) )
+                return false;
+            if ( hv.istarts_with( v ) != ( hl.compare( 0, vl.size(), vl ) == 0 ) )
+                return false;
+            if ( hv.iends_with( v ) != ( hl.size() >= vl.size() && hl.compare( hl.size() - vl.size(), vl.size(), vl ) == 0 ) )
+                return false;
+
+            for ( std::size_t pos = 0; pos < h.size(); pos += 1 + pos / 2 )
+            {
+                if ( hv.ifind( v, pos ) != view( hl ).find( view( vl ), pos ) )
+                    return false;
+                if ( hv.ifind( tv, pos ) != view( hl ).find( view( tl ), pos ) )
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "string_view: Allows to compare and search ignoring ASCII case as via lowercase copies " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"icompare() and friends are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    EXPECT( case_insensitive_as_lowercase_copies<char   >( 1u ) );
+    EXPECT( case_insensitive_as_lowercase_copies<wchar_t>( 2u ) );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( case_insensitive_as_lowercase_copies<char16_t>( 3u ) );
+    EXPECT( case_insensitive_as_lowercase_copies<char32_t>( 4u ) );
+#endif
+#endif
+}
+
+CASE( "string_view: Allows to match HTTP header names ignoring ASCII case " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"icompare() and friends are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    string_view header( "CONTENT-type: text/plain; Charset=UTF-8" );
+
+    EXPECT( header.istarts_with( "Content-Type:" ) );
+    EXPECT( header.iends_with( "utf-8" ) );
+    EXPECT( header.ifind( "charset=" ) == size_type( 26 ) );
+    EXPECT( header.ifind( "CHARSET=", 27 ) == string_view::npos );
+    EXPECT( string_view( "Host" ).iequals( "hOST" ) );
+    EXPECT( string_view( "Host" ).icompare( "HOSTS" ) < 0 );
+    EXPECT( string_view( "Hosu" ).icompare( "HOST"  ) > 0 );
+    EXPECT( string_view( "[" ).icompare( "a" ) < 0 );
+    EXPECT( ! string_view( "\xC1" ).iequals( "\xE1" ) );
+#endif
+}
+
+CASE( "string_view: Allows to constexpr-compare and search ignoring ASCII case (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"icompare() and friends are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    static_assert( string_view( "Keep-Alive" ).iequals( string_view( "keep-alive" ) ), "" );
+    static_assert( string_view( "Keep-Alive" ).icompare( string_view( "KEEP" ) ) > 0, "" );
+    static_assert( string_view( "Keep-Alive" ).istarts_with( string_view( "KEEP" ) ), "" );
+    static_assert( string_view( "Keep-Alive" ).iends_with( string_view( "ALIVE" ) ), "" );
+    static_assert( string_view( "Keep-Alive" ).ifind( string_view( "-a" ) ) == 4, "" );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW
+
+// views of each size that differ at each position from the front and from the back:
+
+template< class CharT >
+bool common_affixes_as_naive_loop()
+{
+    typedef basic_string_view<CharT> view;
+
+    for ( std::size_t n = 0; n != 80; ++n )
+    {
+        std::vector<CharT> a( n + 1, CharT( 'a' ) );
+
+        for ( std::size_t at = 0; at <= n; ++at )
+        {
+            std::vector<CharT> b( a );
+            b[at] = CharT( 'b' );
+
+            const view va( data( a ), n );
+            const view vb( data( b ), n );
+            const view vb1( data( b ), n + 1 );
+            const std::size_t prefix = at == n ? n : at;
+            const std::size_t suffix = at == n ? n : n - 1 - at;
+
+            if (   va.common_prefix_length( vb  ) != prefix
+                || va.common_suffix_length( vb  ) != suffix
+                || va.common_prefix_length( vb1 ) != prefix
+                || vb1.common_suffix_length( va.substr( 0, at ) ) != ( at == n ? 0 : (std::min)( at, n - at ) )
+                || va.mismatch_pos( vb ) != ( at == n ? view::npos : at )
+                || va.rmismatch_pos( vb ) != ( at == n ? view::npos : at ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "string_view: Allows to obtain the length of the common prefix and suffix of string_views, and their first and last mismatch " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"common_prefix_length() and friends are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#else
+    string_view a( "/usr/local/include/nonstd" );
+
+    EXPECT( a.common_prefix_length( "/usr/local/lib"    ) == size_type( 11 ) );
+    EXPECT( a.common_suffix_length( "/opt/nonstd"       ) == size_type(  7 ) );
+    EXPECT( a.mismatch_pos ( "/usr/local/lib"    ) == size_type( 11 ) );
+    EXPECT( a.rmismatch_pos( "/opt/nonstd"       ) == size_type( 17 ) );
+    EXPECT( a.mismatch_pos ( a ) == string_view::npos );
+    EXPECT( a.rmismatch_pos( a ) == string_view::npos );
+    EXPECT( string_view( "/usr" ).mismatch_pos( a ) == string_view::npos );
+    EXPECT( a.mismatch_pos( "/usr" ) == size_type( 4 ) );
+    EXPECT( string_view().common_prefix_length( a ) == size_type( 0 ) );
+
+    EXPECT( common_affixes_as_naive_loop<char   >() );
+    EXPECT( common_affixes_as_naive_loop<wchar_t>() );
+#if nssv_HAVE_WCHAR16_T
+    EXPECT( common_affixes_as_naive_loop<char16_t>() );
+    EXPECT( common_affixes_as_naive_loop<char32_t>() );
+#endif
+#endif
+}
+
+CASE( "string_view: Allows to constexpr-obtain the length of the common prefix and suffix of string_views (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"common_prefix_length() and friends are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    static_assert( string_view( "interstellar" ).common_prefix_length( string_view( "internet" ) ) == 5, "" );
+    static_assert( string_view( "interstellar" ).common_suffix_length( string_view( "cellar" ) ) == 5, "" );
+    static_assert( string_view( "interstellar" ).mismatch_pos( string_view( "internet" ) ) == 5, "" );
+    static_assert( string_view( "interstellar" ).rmismatch_pos( string_view( "cellar" ) ) == 6, "" );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER
+
+// known hash values of the first n bytes of ( 131 * i + 7 ) mod 256,
+// unseeded and seeded, to keep the output stable:
+
+inline bool hash_as_known_values()
+{
+    struct { std::size_t n; std::uint64_t h; std::uint64_t hs; } const known[] =
+    {
+        {    0, 0x0409638ee2bde459ull, 0x2b4e3df129b1f482ull },
+        {    1, 0xfddeeeea8cc2709cull, 0x9238c26d4f1abae8ull },
+        {    3, 0x8e4fbcba74db6389ull, 0xf63df5be5f89db5eull },
+        {    4, 0xe51e02146ebec632ull, 0x5bb3f19f5f9b0819ull },
+        {    8, 0x6ad2fe40e65970edull, 0x60c19ebfa927db43ull },
+        {    9, 0x46d8d63df02669a1ull, 0x1af0cd34c6caf25dull },
+        {   16, 0x47340008ff15ca56ull, 0x3a2aa0157d823d7cull },
+        {   17, 0x8700d4e8fbdc902bull, 0x92d1265818c04409ull },
+        {   48, 0xb61c237f7239a6efull, 0x407c0e04666300e2ull },
+        {   49, 0x601195ce2f825428ull, 0x29a0aef7dc5822c2ull },
+        {  128, 0x2406cde20f0004b8ull, 0xb84b44d96089202dull },
+        {  256, 0x324212f8c03583baull, 0xab6e0888477d671full },
+        {  257, 0x944a0fca01ed0375ull, 0x4eaec34c7d67b8b3ull },
+        {  512, 0xf949ffc209425bc0ull, 0x0a79c4c20c1309ebull },
+        {  513, 0xb06a9a689d71ba92ull, 0xf1f84996913adc8cull },
+        { 1500, 0x97cb617d359afb61ull, 0x3a885065980fd31cull },
+    };
+
+    std::string text;
+    for ( unsigned i = 0; i != 1500; ++i )
+        text += static_cast<char>( ( 131 * i + 7 ) & 0xff );
+
+    for ( std::size_t k = 0; k != sizeof known / sizeof known[0]; ++k )
+    {
+        const string_view v( text.data(), known[k].n );
+
+        if ( sv_hash( v ) != known[k].h || sv_hash( v, 0x0123456789abcdefull ) != known[k].hs )
+            return false;
+    }
+    return true;
+}
+
+// hash of each prefix at each offset as via the constant-evaluation path:
+
+inline bool hash_as_constant_evaluation()
+{
+    std::string text;
+    for ( unsigned i = 0; i != 1200; ++i )
+        text += static_cast<char>( ( i * i * 31 ) >> 3 );
+
+    for ( std::size_t offset = 0; offset != 4; ++offset )
+    {
+        for ( std::size_t n = 0; n + offset <= text.size(); n += 1 + n / 16 )
+        {
+            char const * s = text.data() + offset;
+
+            if ( sv_hash( string_view( s, n ), n ) != nonstd::sv_lite::detail::hash_bytes( nonstd::sv_lite::detail::hash_value_reader<char>{ s }, n, n ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "sv_hash: Allows to obtain a seeded 64-bit hash of a string_view that is the same on every platform (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"sv_hash() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    EXPECT( hash_as_known_values() );
+    EXPECT( hash_as_constant_evaluation() );
+
+    EXPECT( sv_hash( "hello" ) == sv_hash( string_view( "hello, world" ).substr( 0, 5 ) ) );
+    EXPECT( sv_hash( "hello" ) != sv_hash( "hello", 1 ) );
+    EXPECT( sv_hash( "hello" ) != sv_hash( "hellO" ) );
+#if nssv_HAVE_WCHAR16_T && nssv_HAVE_UNICODE_LITERALS
+    EXPECT( sv_hash( u16string_view( u"h\u00e9llo" ) ) == sv_hash( string_view( "h\0\xe9\0l\0l\0o\0", 10 ) ) );
+#endif
+#else
+    EXPECT( !!"sv_hash() is not available (no C++11)." );
+#endif
+}
+
+CASE( "sv_hash: Allows to constexpr-obtain the hash of a string_view (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"sv_hash() is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    static_assert( sv_hash( "hello" ) == 0x0e24bbd9f93f532dull, "" );
+    static_assert( sv_hash( sv_LONG_LITERAL( "0123456789" ) ) == 0x407a7d359d6173f9ull, "" );
+
+    EXPECT( sv_hash( "hello" ) == 0x0e24bbd9f93f532dull );
+    EXPECT( sv_hash( sv_LONG_LITERAL( "0123456789" ) ) == 0x407a7d359d6173f9ull );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_HAVE_CONSTEXPR_14 && nssv_CONFIG_USR_SV_OPERATOR
+
+// dispatch on the hash of a command, confirmed by a single comparison:
+
+inline int dispatch( string_view command )
+{
+    using namespace nonstd::literals::string_view_literals;
+
+    switch ( sv_hash( command ) )
+    {
+        case "start"_svh:   return command == "start"   ? 1 : 0;
+        case "stop"_svh:    return command == "stop"    ? 2 : 0;
+        case "restart"_svh: return command == "restart" ? 3 : 0;
+        case "status"_svh:  return command == "status"  ? 4 : 0;
+        default:            return 0;
+    }
+}
+
+#endif
+
+CASE( "sv_hash: Allows to switch on the hash of a string_view via literal \"_svh\" (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"Literal operator '_svh' is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif ! nssv_CONFIG_USR_SV_OPERATOR
+    EXPECT( !!"Literal operator '_svh' is not available (nssv_CONFIG_USR_SV_OPERATOR=0)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    using namespace nonstd::literals::string_view_literals;
+
+    static_assert(  "hello"_svh == sv_hash( string_view(  "hello" ) ), "" );
+    static_assert( L"hello"_svh == sv_hash( wstring_view( L"hello" ) ), "" );
+    static_assert( u"hello"_svh == sv_hash( u16string_view( u"hello" ) ), "" );
+    static_assert( U"hello"_svh == sv_hash( u32string_view( U"hello" ) ), "" );
+    static_assert( "a\0b"_svh != "a"_svh, "" );
+
+    EXPECT( dispatch( "start"   ) == 1 );
+    EXPECT( dispatch( "stop"    ) == 2 );
+    EXPECT( dispatch( "restart" ) == 3 );
+    EXPECT( dispatch( "status"  ) == 4 );
+    EXPECT( dispatch( "stat"    ) == 0 );
+    EXPECT( dispatch( ""        ) == 0 );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+CASE( "sv_hasher, sv_equal: Allow to hash and compare views, strings and C-strings alike (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"sv_hasher and sv_equal are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    const std::string  s( 40, 'k' );
+    const std::wstring w( 40, L'k' );
+    const sv_hasher hash;
+    const sv_hasher seeded( 42u );
+    const sv_equal  equal;
+
+    EXPECT( hash( s ) == hash( string_view( s ) ) );
+    EXPECT( hash( s ) == hash( s.c_str() ) );
+    EXPECT( hash( s ) == sv_hash( s.c_str() ) );
+    EXPECT( hash( w ) == hash( wstring_view( w ) ) );
+    EXPECT( hash( "abc" ) == hash( std::string( "abc" ) ) );
+    EXPECT( seeded( s ) == seeded( string_view( s ) ) );
+    EXPECT( seeded( s ) != hash( s ) );
+
+    EXPECT(   equal( s, string_view( s ) ) );
+    EXPECT(   equal( s.c_str(), s ) );
+    EXPECT(   equal( "abc", string_view( "abc" ) ) );
+    EXPECT( ! equal( "abc", std::string( "abd" ) ) );
+    EXPECT(   equal( w, w.c_str() ) );
+
+    std::unordered_set<string_view, sv_hasher, sv_equal> set;
+    set.insert( "alpha" );
+    set.insert( "beta"  );
+
+    EXPECT( set.count( string_view( "alpha" ) ) == 1u );
+    EXPECT( set.count( string_view( "gamma" ) ) == 0u );
+#else
+    EXPECT( !!"sv_hasher and sv_equal are not available (no C++11)." );
+#endif
+}
+
+CASE( "sv_hasher, sv_equal: Allow to hash and compare views with custom traits that hash by value (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"sv_hasher and sv_equal are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER && nssv_HAVE_WCHAR16_T
+    typedef basic_string_view<char16_t, reverse_traits> view;
+
+    const std::basic_string<char16_t, reverse_traits> s( 3, u'k' );
+
+    EXPECT( sv_hasher()( view( s.c_str() ) ) == sv_hasher()( u16string_view( u"kkk" ) ) );
+    EXPECT( sv_hasher()( s ) == sv_hasher()( view( s.c_str() ) ) );
+    EXPECT( sv_equal()( s, view( s.c_str() ) ) );
+#else
+    EXPECT( !!"sv_hasher and sv_equal are not available (no C++11)." );
+#endif
+}
+
+CASE( "sv_hasher, sv_equal: Disallow views with traits that do not hash by value (C++11) " "[extension]" )
+{
+#if nssv_CONFIG_CONFIRMS_COMPILATION_ERRORS && ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER
+    sv_hasher()( basic_string_view<char, ci_traits>( "abc" ) );
+    sv_equal()( basic_string_view<char, ci_traits>( "abc" ), basic_string_view<char, ci_traits>( "ABC" ) );
+
+    EXPECT( true );
+#else
+    EXPECT( !!"Compile-time verification not enabled (nssv_CONFIG_CONFIRMS_COMPILATION_ERRORS: 0)." );
+#endif
+}
+
+CASE( "sv_hasher, sv_equal: Allow to look up a std::string key via a string_view, without constructing a string (C++20) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"sv_hasher and sv_equal are not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif defined(__cpp_lib_generic_unordered_lookup)
+    std::unordered_map<std::string, int, sv_hasher, sv_equal> map;
+    map[ "alpha" ] = 1;
+    map[ "beta"  ] = 2;
+
+    const string_view key( "beta, gamma" );
+
+    EXPECT( ( map.find( key.substr( 0, 4 ) ) != map.end() ) );
+    EXPECT( map.find( key.substr( 0, 4 ) )->second == 2 );
+    EXPECT( ( map.find( key.substr( 6 ) ) == map.end() ) );
+    EXPECT( map.count( "alpha" ) == 1u );
+#else
+    EXPECT( !!"Heterogeneous lookup in unordered containers is not available (no C++20)." );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER
+
+// position of each of many keywords, some duplicate, and of their
+// prefixes and neighbours, as via a linear search of the list:
+
+inline bool keywords_as_linear_search()
+{
+    std::vector<std::string> words;
+    for ( unsigned i = 0; i != 3000; ++i )
+        words.push_back( std::string( 1 + ( i * 7 ) % 13, static_cast<char>( 'a' + i % 26 ) ) + std::to_string( ( i * 7919u ) % 2000u ) );
+
+    for ( std::size_t size = 0; size <= words.size(); size += 1 + size )
+    {
+        const keyword_set set( words.begin(), words.begin() + static_cast<std::ptrdiff_t>( size ) );
+
+        if ( set.size() != size )
+            return false;
+
+        for ( std::size_t i = 0; i != words.size(); ++i )
+        {
+            const string_view word( words[i] );
+            const string_view probes[] = { word, word.substr( 0, word.size() - 1 ), word.substr( 1 ) };
+
+            for ( std::size_t k = 0; k != 3; ++k )
+            {
+                const std::size_t pos = static_cast<std::size_t>( std::find( words.begin(), words.begin() + static_cast<std::ptrdiff_t>( size ), probes[k] ) - words.begin() );
+
+                if ( set.find( probes[k] ) != ( pos != size ? pos : string_view::npos ) )
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "keyword_set: Allows to find the position of a keyword in a runtime list as via a linear search (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"keyword_set is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    EXPECT( keywords_as_linear_search() );
+
+    const keyword_set methods = { "GET", "HEAD", "POST", "PUT", "DELETE", "GET" };
+    const keyword_set none;
+
+    EXPECT( methods.size() == 6u );
+    EXPECT( methods[2] == "POST" );
+    EXPECT( methods.find( "GET"    ) == 0u );
+    EXPECT( methods.find( "DELETE" ) == 4u );
+    EXPECT( methods.find( "get"    ) == string_view::npos );
+    EXPECT( methods.find( ""       ) == string_view::npos );
+    EXPECT(   methods.contains( string_view( "PUTS" ).substr( 0, 3 ) ) );
+    EXPECT( ! methods.contains( "PUTS" ) );
+    EXPECT( ! none.contains( "" ) );
+#else
+    EXPECT( !!"keyword_set is not available (no C++11)." );
+#endif
+}
+
+CASE( "keyword_map: Allows to look up the value of a keyword in a runtime list (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"keyword_map is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    const std::vector< std::pair<std::string, int> > entries = { { "SELECT", 1 }, { "FROM", 2 }, { "WHERE", 3 }, { "FROM", 4 } };
+    const basic_keyword_map<char, int> map( entries.begin(), entries.end() );
+
+    EXPECT( map.size() == 4u );
+    EXPECT( *map.find( "SELECT" ) == 1 );
+    EXPECT( *map.find( "FROM"   ) == 2 );
+    EXPECT( *map.find( "WHERE"  ) == 3 );
+    EXPECT( map.find( "select" ) == nssv_nullptr );
+    EXPECT( map.contains( "WHERE" ) );
+#else
+    EXPECT( !!"keyword_map is not available (no C++11)." );
+#endif
+}
+
+CASE( "basic_fixed_keyword_set, basic_fixed_keyword_map: Allow to constexpr-build and search a keyword list (C++14) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_fixed_keyword_set is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_HAVE_CONSTEXPR_14
+    enum method { get, head, post };
+
+    static constexpr string_view keywords[] = { "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH" };
+    static constexpr std::pair<string_view, method> entries[] = { { "GET", get }, { "HEAD", head }, { "POST", post } };
+
+    constexpr auto set = make_keyword_set( keywords );
+    constexpr auto map = make_keyword_map( entries );
+
+    static_assert( set.size() == 9u, "" );
+    static_assert( set.find( "GET"   ) == 0u, "" );
+    static_assert( set.find( "PATCH" ) == 8u, "" );
+    static_assert( set.find( "PATC"  ) == string_view::npos, "" );
+    static_assert( *map.find( "POST" ) == post, "" );
+    static_assert( map.find( "PUT" ) == nssv_nullptr, "" );
+
+    for ( std::size_t i = 0; i != set.size(); ++i )
+    {
+        EXPECT( set.find( std::string( keywords[i] ) ) == i );
+    }
+    EXPECT( ! set.contains( "get" ) );
+    EXPECT( *map.find( std::string( "HEAD" ) ) == head );
+#else
+    EXPECT( !!"C++14 constexpr is not available (no C++14)" );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER
+
+// many insertions, lookups and erasures of keys of several lengths, as via std::map:
+
+inline bool string_map_as_std_map()
+{
+    basic_string_map<char, unsigned> map;
+    std::map<std::string, unsigned> ref;
+
+    for ( unsigned i = 0; i != 60000; ++i )
+    {
+        const unsigned r = i * 2654435761u;
+        std::string key = std::to_string( ( r >> 8 ) % 3000u );
+        key.resize( key.size() + ( r >> 4 ) % 40u, '.' );
+
+        switch ( r & 3u )
+        {
+            case 0:
+            case 1:
+                if ( map.emplace( key, i ).second != ref.emplace( key, i ).second )
+                    return false;
+                break;
+            case 2:
+                if ( map.erase( key ) != ( ref.erase( key ) == 1u ) )
+                    return false;
+                break;
+            default:
+                if ( map.find( string_view( key ) ) != nssv_nullptr ? *map.find( key ) != ref[ key ] : ref.count( key ) != 0 )
+                    return false;
+        }
+
+        if ( map.size() != ref.size() )
+            return false;
+    }
+
+    for ( basic_string_map<char, unsigned>::const_iterator it = map.begin(); it != map.end(); ++it )
+    {
+        if ( ref[ std::string( it->first ) ] != it->second )
+            return false;
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "string_map: Allows to insert, find and erase entries as via std::map (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_string_map is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    EXPECT( string_map_as_std_map() );
+#else
+    EXPECT( !!"basic_string_map is not available (no C++11)." );
+#endif
+}
+
+CASE( "string_map: Allows to look up a key as a view, a string or a C-string, and keeps a copy of the key (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_string_map is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    basic_string_map<char, int> map;
+    std::string key( "temperature" );
+
+    map[ key ] = 1;
+    map[ string_view( "pressure, humidity" ).substr( 0, 8 ) ] = 2;
+    EXPECT( map.insert( "humidity", 3 ).second );
+    EXPECT( ! map.insert( "humidity", 4 ).second );
+
+    key.assign( "overwritten" );
+
+    EXPECT( map.size() == 3u );
+    EXPECT( *map.find( "temperature" ) == 1 );
+    EXPECT( *map.find( std::string( "pressure" ) ) == 2 );
+    EXPECT( *map.find( string_view( "humidity" ) ) == 3 );
+    EXPECT( ! map.contains( key ) );
+    EXPECT( map.begin()->first == "temperature" );
+
+    basic_string_map<char, int> copy( map );
+    map.clear();
+
+    EXPECT( map.empty() );
+    EXPECT( ! map.contains( "temperature" ) );
+    EXPECT( *copy.find( "temperature" ) == 1 );
+    EXPECT( copy.erase( "temperature" ) );
+    EXPECT( ! copy.erase( "temperature" ) );
+    EXPECT( copy.size() == 2u );
+#else
+    EXPECT( !!"basic_string_map is not available (no C++11)." );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER
+
+// a key of a user type that converts to a view:
+
+struct metric_name
+{
+    std::string text;
+
+    operator string_view() const { return string_view( text.data(), text.size() ); }
+};
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "string_map: Allows to use a key of a type that converts to a view (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"basic_string_map is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif nssv_CPP11_OR_GREATER
+    basic_string_map<char, int> map;
+    const metric_name name = { "temperature" };
+
+    map[ name ] = 1;
+    EXPECT( map.insert( metric_name{ "pressure" }, 2 ).second );
+
+    EXPECT( *map.find( "temperature" ) == 1 );
+    EXPECT( *map.find( name ) == 1 );
+    EXPECT( map.contains( metric_name{ "pressure" } ) );
+    EXPECT( map.erase( name ) );
+    EXPECT( ! map.contains( "temperature" ) );
+#else
+    EXPECT( !!"basic_string_map is not available (no C++11)." );
+#endif
+}
+
+#if ! nssv_USES_STD_STRING_VIEW && nssv_CPP11_OR_GREATER && nssv_CONFIG_STRING_POOL
+
+// intern many names on several threads, each in its own order; each name
+// must yield one view and one id, the ids being 0 up to the number of names:
+
+inline bool pool_as_concurrent_interning()
+{
+    const unsigned threads = 4;
+    const unsigned count   = 5000;
+
+    std::vector<std::string> names;
+    for ( unsigned i = 0; i != count; ++i )
+        names.push_back( "tag." + std::to_string( i ) );
+
+    string_pool pool;
+    std::vector< std::vector<string_pool::entry> > entries( threads );
+    std::vector<std::thread> workers;
+
+    for ( unsigned t = 0; t != threads; ++t )
+    {
+        workers.push_back( std::thread( [&, t]{
+            for ( unsigned i = 0; i != count; ++i )
+                entries[t].push_back( pool.intern( names[ ( i * 7u + t * 1231u ) % count ] ) ); } ) );
+    }
+
+    for ( unsigned t = 0; t != threads; ++t )
+        workers[t].join();
+
+    if ( pool.size() != count )
+        return false;
+
+    std::vector<char const *> data( count, nssv_nullptr );
+
+    for ( unsigned t = 0; t != threads; ++t )
+    {
+        for ( unsigned i = 0; i != count; ++i )
+        {
+            const string_pool::entry e = entries[t][i];
+
+            if ( e.view != names[ ( i * 7u + t * 1231u ) % count ] || e.id >= count || pool.view( e.id ).data() != e.view.data() )
+                return false;
+
+            if ( data[ e.id ] != nssv_nullptr && data[ e.id ] != e.view.data() )
+                return false;
+
+            data[ e.id ] = e.view.data();
+        }
+    }
+    return true;
+}
+
+#endif // nssv_USES_STD_STRING_VIEW
+
+CASE( "string_pool: Allows to intern a string as a stable view with a dense id (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"string_pool is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif ! nssv_CONFIG_STRING_POOL
+    EXPECT( !!"string_pool is not available (nssv_CONFIG_STRING_POOL=0)." );
+#elif nssv_CPP11_OR_GREATER
+    string_pool pool;
+    std::string name( "cpu.load" );
+
+    const string_pool::entry a = pool.intern( name );
+    const string_pool::entry b = pool.intern( "mem.free" );
+
+    name.assign( "overwritten" );
+
+    const string_pool::entry c = pool.intern( string_view( "cpu.load.avg" ).substr( 0, 8 ) );
+
+    EXPECT( a.id == 0u );
+    EXPECT( b.id == 1u );
+    EXPECT( c.id == 0u );
+    EXPECT( a.view == "cpu.load" );
+    EXPECT( a.view.data() == c.view.data() );
+    EXPECT( pool.view( 1u ) == "mem.free" );
+    EXPECT( pool.intern( "" ).id == 2u );
+    EXPECT( pool.size() == 3u );
+
+    for ( unsigned i = 0; i != 20000; ++i )
+    {
+        pool.intern( std::to_string( i ) );
+    }
+
+    EXPECT( pool.size() == 20003u );
+    EXPECT( pool.view( 20002u ) == "19999" );
+    EXPECT( pool.intern( "cpu.load" ).view.data() == a.view.data() );
+#else
+    EXPECT( !!"string_pool is not available (no C++11)." );
+#endif
+}
+
+CASE( "string_pool: Allows to intern strings concurrently (C++11) " "[extension]" )
+{
+#if nssv_USES_STD_STRING_VIEW
+    EXPECT( !!"string_pool is not available (nssv_USES_STD_STRING_VIEW=1)." );
+#elif ! nssv_CONFIG_STRING_POOL
+    EXPECT( !!"string_pool is not available (nssv_CONFIG_STRING_POOL=0)." );
+#elif nssv_CPP11_OR_GREATER
+    EXPECT( pool_as_concurrent_interning() );
+#else
+    EXPECT( !!"string_pool is not available (no C++11)." );
+#endif
+}
+
 CASE( "tweak header: reads tweak header if supported " "[tweak]" )
 {
 #if nssv_HAVE_TWEAK_HEADER